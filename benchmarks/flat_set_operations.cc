@@ -0,0 +1,147 @@
+#include <algorithm> // set_difference, set_intersection, set_union, sort, unique
+#include <chrono>
+#include <cstdint>   // uint32_t
+#include <iomanip>   // setw
+#include <iostream>
+#include <iterator>  // inserter
+#include <random>
+#include <vector>
+
+#include <boost/container/flat_set.hpp>
+
+#include "sdd/util/set_operations.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Compare the operations on sorted arrays used by values::flat_set<unsigned int> with the
+// standard algorithms writing into a boost::container::flat_set, as flat_set used to do.
+
+using set_type = boost::container::flat_set<std::uint32_t>;
+using clock_type = std::chrono::steady_clock;
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Draw a set of n integers lower than max.
+set_type
+draw(std::mt19937& gen, std::size_t n, std::uint32_t max)
+{
+  std::uniform_int_distribution<std::uint32_t> dist(0, max - 1);
+  set_type res;
+  while (res.size() < n)
+  {
+    res.insert(dist(gen));
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Get the number of nanoseconds per call of an operation.
+template <typename Operation>
+double
+measure(std::size_t iterations, Operation&& op)
+{
+  std::size_t sink = 0;
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    sink += op();
+  }
+  const auto end = clock_type::now();
+  // Prevent the compiler from removing the operations.
+  if (sink == static_cast<std::size_t>(-1))
+  {
+    std::cerr << sink;
+  }
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Measure an operation with the standard algorithm and with all instruction sets.
+template <typename Standard, typename Kernel>
+void
+compare( const char* name, const set_type& a, const set_type& b, std::size_t iterations
+       , Standard&& standard, Kernel&& kernel)
+{
+  std::vector<std::uint32_t> out(a.size() + b.size() + sdd::util::set_operations_padding);
+  const auto pa = &*a.begin();
+  const auto pb = &*b.begin();
+  const auto stl = measure(iterations, [&]
+                                       {
+                                         set_type res;
+                                         standard(a, b, std::inserter(res, res.begin()));
+                                         return res.size();
+                                       });
+  std::cout << std::setw(13) << name << std::setw(7) << a.size() << std::setw(7) << b.size()
+            << std::setw(10) << stl;
+  for (const auto level : { sdd::util::simd_level::none, sdd::util::simd_level::sse42
+                          , sdd::util::simd_level::avx2})
+  {
+    if (level > sdd::util::detected_simd_level())
+    {
+      std::cout << std::setw(10) << "-";
+      continue;
+    }
+    std::cout << std::setw(10) << measure(iterations, [&]
+                                                      {
+                                                        return kernel( level, pa, a.size(), pb
+                                                                     , b.size(), out.data());
+                                                      });
+  }
+  std::cout << '\n';
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+int
+main()
+{
+  using sdd::util::simd_level;
+  std::mt19937 gen(0);
+  std::cout << std::fixed << std::setprecision(1)
+            << "    operation    |a|    |b|       STL    scalar    SSE4.2      AVX2  (ns)\n";
+  const std::size_t sizes[][2] = {{8, 8}, {64, 64}, {1000, 1000}, {10000, 10000}, {16, 10000}};
+  for (const auto& size : sizes)
+  {
+    // Values are dense enough to have many common values.
+    const auto max = static_cast<std::uint32_t>(2 * (size[0] + size[1]));
+    const auto a = draw(gen, size[0], max);
+    const auto b = draw(gen, size[1], max);
+    const std::size_t iterations = 20000000 / (size[0] + size[1]);
+
+    compare( "union", a, b, iterations
+           , [](const set_type& x, const set_type& y, std::insert_iterator<set_type> out)
+               {
+                 std::set_union(x.begin(), x.end(), y.begin(), y.end(), out);
+               }
+           , [](simd_level l, const std::uint32_t* x, std::size_t nx, const std::uint32_t* y
+               , std::size_t ny, std::uint32_t* out)
+               {
+                 return sdd::util::set_union(l, x, nx, y, ny, out);
+               });
+    compare( "intersection", a, b, iterations
+           , [](const set_type& x, const set_type& y, std::insert_iterator<set_type> out)
+               {
+                 std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), out);
+               }
+           , [](simd_level l, const std::uint32_t* x, std::size_t nx, const std::uint32_t* y
+               , std::size_t ny, std::uint32_t* out)
+               {
+                 return sdd::util::set_intersection(l, x, nx, y, ny, out);
+               });
+    compare( "difference", a, b, iterations
+           , [](const set_type& x, const set_type& y, std::insert_iterator<set_type> out)
+               {
+                 std::set_difference(x.begin(), x.end(), y.begin(), y.end(), out);
+               }
+           , [](simd_level l, const std::uint32_t* x, std::size_t nx, const std::uint32_t* y
+               , std::size_t ny, std::uint32_t* out)
+               {
+                 return sdd::util::set_difference(l, x, nx, y, ny, out);
+               });
+  }
+  return 0;
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -4,8 +4,12 @@
 #include <cstdint> // uint16_t, uint32_t
 #include <string>
 
+#include "sdd/values_manager.hh" // conf3 translates interval_sets, which needs their manager
+#include "sdd/mem/cache_eviction.hh"
 #include "sdd/values/bitset.hh"
 #include "sdd/values/flat_set.hh"
+#include "sdd/values/interval_set.hh"
+#include "sdd/values/roaring.hh"
 
 namespace sdd {
 
@@ -44,6 +48,70 @@ struct default_configuration
   /// @brief The size of the cache of homomorphism applications.
   std::size_t hom_cache_size;
 
+  /// @brief The size of the cache of arcs decoded from flat SDD.
+  std::size_t proto_arcs_cache_size;
+
+  /// @brief Tell if the cache of decoded arcs grows when it misses too often.
+  bool proto_arcs_cache_adaptive;
+
+  /// @brief The miss rate above which the adaptive cache of decoded arcs grows.
+  double proto_arcs_cache_max_miss_rate;
+
+  /// @brief The size the adaptive cache of decoded arcs can't grow beyond.
+  std::size_t proto_arcs_cache_max_size;
+
+  /// @brief The eviction policy of all caches: mem::lfu_eviction, mem::clock_eviction or
+  /// mem::slru_eviction.
+  using cache_eviction = mem::lfu_eviction;
+
+  /// @brief Tell if the caches of operations on SDD (union, intersection, difference) are
+  /// direct-mapped: each new entry overwrites the one with the same hash index.
+  ///
+  /// cache_eviction is then only used by the other caches.
+  static constexpr bool direct_mapped_sdd_caches = false;
+
+  /// @brief The number of threads which evaluate operations in parallel.
+  ///
+  /// Only used when the library is thread-safe. With 0 threads, all operations are evaluated by
+  /// the calling thread.
+  std::size_t nb_worker_threads;
+
+  /// @brief The minimal number of values whose successors are summed by a single parallel task.
+  std::size_t sum_grain_size;
+
+  /// @brief Tell if the operands of Saturation Sums and Intersections are evaluated as parallel
+  /// tasks.
+  ///
+  /// Only used when the library is thread-safe.
+  bool parallel_saturation;
+
+  /// @brief Tell if the unique tables of SDD, proto environments and homomorphisms use open
+  /// addressing rather than chaining.
+  static constexpr bool open_addressing_unique_tables = false;
+
+  /// @brief Ask the system to back the memory of unified SDD, proto environments and
+  /// homomorphisms with huge pages.
+  bool unique_tables_huge_pages;
+
+  /// @brief The number of unreferenced SDD, proto environments or homomorphisms which triggers
+  /// the sweep of their unique table.
+  ///
+  /// Until then, they are kept in the table and reused if they are built again. When 0, they are
+  /// erased as soon as they are no longer referenced.
+  std::size_t gc_threshold;
+
+  /// @brief Tell if the number of combinations of each node is kept across calls to SDD::size().
+  ///
+  /// Counting again an SDD, or an SDD which shares nodes with an already counted one, then only
+  /// visits the new nodes. Entries are erased with the nodes they describe.
+  bool combinations_cache;
+
+  /// @brief Tell if Saturation Fixpoints apply each G operand until a local fixpoint before
+  /// applying the next one.
+  ///
+  /// This chaining strategy usually needs far fewer rounds for models like Petri nets.
+  bool saturation_chaining;
+
   /// @brief Tell if FPU registers shoud be preserved when using Expressions.
   static constexpr bool expression_preserve_fpu_registers = false;
 
@@ -63,6 +131,17 @@ struct default_configuration
     , sdd_sum_cache_size(1000000)
     , hom_unique_table_size(1000000)
     , hom_cache_size(1000000)
+    , proto_arcs_cache_size(100000)
+    , proto_arcs_cache_adaptive(false)
+    , proto_arcs_cache_max_miss_rate(0.5)
+    , proto_arcs_cache_max_size(10000000)
+    , nb_worker_threads(0)
+    , sum_grain_size(32)
+    , parallel_saturation(false)
+    , unique_tables_huge_pages(false)
+    , gc_threshold(0)
+    , combinations_cache(false)
+    , saturation_chaining(false)
     , final_cleanup(true)
   {}
 };
@@ -83,6 +162,34 @@ struct flat_set_default_configuration
 
 /*------------------------------------------------------------------------------------------------*/
 
+struct roaring_default_configuration
+  : public default_configuration
+{
+  /// @brief The size of the hash table that stores roaring<>.
+  std::size_t roaring_unique_table_size;
+
+  roaring_default_configuration()
+    : default_configuration()
+    , roaring_unique_table_size(1000)
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct interval_set_default_configuration
+  : public default_configuration
+{
+  /// @brief The size of the hash table that stores interval_set<>.
+  std::size_t interval_set_unique_table_size;
+
+  interval_set_default_configuration()
+    : default_configuration()
+    , interval_set_unique_table_size(1000)
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 struct conf0
   : public default_configuration
 {
@@ -160,6 +267,66 @@ struct conf2
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Like conf1, with values stored as intervals.
+///
+/// Sets of values are shifted and rebuilt at once in proto nodes, in O(#intervals).
+struct conf3
+  : public interval_set_default_configuration
+{
+  using Identifier = std::string;
+  using Values     = values::interval_set<unsigned int>;
+
+  template <typename InputIterator>
+  static
+  unsigned int
+  common(InputIterator it, InputIterator end)
+  noexcept
+  {
+    return *std::min_element(it, end);
+  }
+
+  /// @brief The values of an interval_set are sorted, the first one is the minimum.
+  static
+  unsigned int
+  common(Values::const_iterator it, Values::const_iterator)
+  noexcept
+  {
+    return *it;
+  }
+
+  static
+  unsigned int
+  shift(unsigned int v, unsigned int k)
+  noexcept
+  {
+    return v - k;
+  }
+
+  static
+  Values
+  shift(const Values& values, unsigned int k)
+  {
+    return values.translate_down(k);
+  }
+
+  static
+  unsigned int
+  rebuild(unsigned int v, unsigned int k)
+  noexcept
+  {
+    return v + k;
+  }
+
+  static
+  Values
+  rebuild(const Values& values, unsigned int k)
+  {
+    return values.translate_up(k);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 } // namespace sdd
 
 #endif // _SDD_CONF_DEFAULT_CONFIGURATIONS_HH_
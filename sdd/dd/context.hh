@@ -1,7 +1,8 @@
 #ifndef _SDD_DD_CONTEXT_HH_
 #define _SDD_DD_CONTEXT_HH_
 
-#include <memory> // make_shared, shared_ptr
+#include <memory>      // make_shared, shared_ptr
+#include <type_traits> // conditional
 
 #include "sdd/dd/context_fwd.hh"
 #include "sdd/dd/definition_fwd.hh"
@@ -10,6 +11,7 @@
 #include "sdd/dd/sum.hh"
 #include "sdd/dd/top.hh"
 #include "sdd/mem/cache.hh"
+#include "sdd/mem/direct_mapped_cache.hh"
 
 namespace sdd { namespace dd {
 
@@ -26,14 +28,22 @@ class context
 {
 public:
 
+  /// @brief The type of a cache of operations on SDD.
+  template <typename Operation>
+  using cache_type
+    = typename std::conditional< C::direct_mapped_sdd_caches
+                               , mem::direct_mapped_cache<context, Operation, top<C>>
+                               , mem::cache<context, Operation, top<C>, typename C::cache_eviction>
+                               >::type;
+
   /// @brief Cache parameterized by the difference operation and the top error.
-  using difference_cache_type = mem::cache<context, difference_op<C>, top<C>>;
+  using difference_cache_type = cache_type<difference_op<C>>;
 
   /// @brief Cache parameterized by the intersection operation and the top error.
-  using intersection_cache_type = mem::cache<context, intersection_op<C>, top<C>>;
+  using intersection_cache_type = cache_type<intersection_op<C>>;
 
   /// @brief Cache parameterized by the sum operation and the top error.
-  using sum_cache_type = mem::cache<context, sum_op<C>, top<C>>;
+  using sum_cache_type = cache_type<sum_op<C>>;
 
 private:
 
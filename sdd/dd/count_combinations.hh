@@ -1,29 +1,300 @@
 #ifndef _SDD_DD_COUNT_COMBINATIONS_HH_
 #define _SDD_DD_COUNT_COMBINATIONS_HH_
 
+#include <cstdint> // uint64_t
+#include <deque>
+#include <limits>
+#include <memory>  // unique_ptr
+#include <mutex>   // lock_guard
 #include <unordered_map>
+#include <vector>
 
+#include <boost/container/small_vector.hpp>
+
+#include "sdd/internal_manager_fwd.hh"
 #include "sdd/dd/count_combinations_fwd.hh"
 #include "sdd/dd/definition.hh"
+#include "sdd/util/concurrency.hh"
 #include "sdd/values/size.hh"
 
 namespace sdd { namespace dd {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief A number of combinations, stored in 64 bits when it fits.
+struct combinations
+{
+  /// @brief The number of combinations, when big is null.
+  std::uint64_t small;
+
+  /// @brief The number of combinations, when it doesn't fit in 64 bits.
+  const boost::multiprecision::cpp_int* big;
+
+  /// @brief Get the number of combinations.
+  boost::multiprecision::cpp_int
+  value()
+  const
+  {
+    return big ? *big : boost::multiprecision::cpp_int(small);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Map node identities to their number of combinations.
+///
+/// A node is identified by the unification identifiers of its environment and of the SDD which
+/// holds it, which are never reused. Entries are stored in place with linear probing.
+class combinations_memo
+{
+private:
+
+  struct slot
+  {
+    std::uint64_t env;
+    std::uint64_t node;
+    combinations count;
+  };
+
+  /// @brief Mark a free slot; no SDD has this unification identifier.
+  static constexpr std::uint64_t free_slot = std::numeric_limits<std::uint64_t>::max();
+
+  std::vector<slot> slots_;
+  std::size_t size_;
+
+public:
+
+  combinations_memo()
+    : slots_(64, slot{0, free_slot, combinations{0, nullptr}})
+    , size_(0)
+  {}
+
+  /// @brief Get the number of combinations of a node, if it was stored.
+  const combinations*
+  find(std::uint64_t env, std::uint64_t node)
+  const noexcept
+  {
+    for (auto i = index(env, node); ; i = (i + 1) & (slots_.size() - 1))
+    {
+      const auto& s = slots_[i];
+      if (s.node == free_slot)
+      {
+        return nullptr;
+      }
+      if (s.node == node and s.env == env)
+      {
+        return &s.count;
+      }
+    }
+  }
+
+  /// @brief Store the number of combinations of a node which is not already stored.
+  void
+  insert(std::uint64_t env, std::uint64_t node, combinations count)
+  {
+    if (2 * (size_ + 1) > slots_.size())
+    {
+      std::vector<slot> old(slots_.size() * 2, slot{0, free_slot, combinations{0, nullptr}});
+      old.swap(slots_);
+      for (const auto& s : old)
+      {
+        if (s.node != free_slot)
+        {
+          place(s);
+        }
+      }
+    }
+    place(slot{env, node, count});
+    ++size_;
+  }
+
+private:
+
+  std::size_t
+  index(std::uint64_t env, std::uint64_t node)
+  const noexcept
+  {
+    auto h = (env * 0x9e3779b97f4a7c15ull) ^ node;
+    h ^= h >> 29;
+    return static_cast<std::size_t>(h * 0xbf58476d1ce4e5b9ull >> 17) & (slots_.size() - 1);
+  }
+
+  void
+  place(const slot& s)
+  noexcept
+  {
+    auto i = index(s.env, s.node);
+    while (slots_[i].node != free_slot)
+    {
+      i = (i + 1) & (slots_.size() - 1);
+    }
+    slots_[i] = s;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Keep the number of combinations of nodes across several countings.
+///
+/// There is one such cache per manager, used by count_combinations() when the configuration
+/// enables it. The entries of a node are erased as soon as it's no longer referenced.
+class combinations_cache
+{
+  // Can't copy a combinations_cache.
+  combinations_cache(const combinations_cache&) = delete;
+  combinations_cache& operator=(const combinations_cache&) = delete;
+
+private:
+
+  /// @brief The number of combinations of a node in an environment.
+  struct entry
+  {
+    std::uint64_t env;
+    std::uint64_t small;
+    std::unique_ptr<const boost::multiprecision::cpp_int> big;
+  };
+
+  /// @brief Tell if the configuration enables this cache.
+  const bool enabled_;
+
+  /// @brief Protect entries, which are shared by all threads.
+  mutable util::mutex mutex_;
+
+  /// @brief The entries of each node, indexed by the unification identifier of its SDD.
+  ///
+  /// A node is usually counted in a single environment.
+  std::unordered_map<std::uint64_t, boost::container::small_vector<entry, 1>> entries_;
+
+  /// @brief The number of entries.
+  std::size_t size_;
+
+public:
+
+  explicit combinations_cache(bool enabled)
+    : enabled_(enabled)
+    , mutex_()
+    , entries_()
+    , size_(0)
+  {}
+
+  bool
+  enabled()
+  const noexcept
+  {
+    return enabled_;
+  }
+
+  /// @brief Get the number of combinations of a node in an environment, if it was stored.
+  bool
+  find(std::uint64_t env, std::uint64_t node, combinations& res)
+  const
+  {
+    std::lock_guard<util::mutex> lock(mutex_);
+    const auto search = entries_.find(node);
+    if (search != entries_.end())
+    {
+      for (const auto& e : search->second)
+      {
+        if (e.env == env)
+        {
+          res = combinations{e.small, e.big.get()};
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /// @brief Store the number of combinations of a node in an environment.
+  /// @return The stored number, which doesn't refer to count.
+  combinations
+  insert(std::uint64_t env, std::uint64_t node, const combinations& count)
+  {
+    std::lock_guard<util::mutex> lock(mutex_);
+    auto& node_entries = entries_[node];
+    for (const auto& e : node_entries)
+    {
+      // Another thread already counted this node.
+      if (e.env == env)
+      {
+        return combinations{e.small, e.big.get()};
+      }
+    }
+    std::unique_ptr<const boost::multiprecision::cpp_int> big;
+    if (count.big)
+    {
+      big.reset(new boost::multiprecision::cpp_int(*count.big));
+    }
+    node_entries.push_back(entry{env, count.small, std::move(big)});
+    ++size_;
+    return combinations{node_entries.back().small, node_entries.back().big.get()};
+  }
+
+  /// @brief Erase all entries of a node.
+  void
+  erase(std::uint64_t node)
+  {
+    std::lock_guard<util::mutex> lock(mutex_);
+    const auto search = entries_.find(node);
+    if (search != entries_.end())
+    {
+      size_ -= search->second.size();
+      entries_.erase(search);
+    }
+  }
+
+  /// @brief Erase all entries.
+  void
+  clear()
+  {
+    std::lock_guard<util::mutex> lock(mutex_);
+    entries_.clear();
+    size_ = 0;
+  }
+
+  /// @brief Get the number of entries.
+  std::size_t
+  size()
+  const
+  {
+    std::lock_guard<util::mutex> lock(mutex_);
+    return size_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief Visitor to count the number of paths in an SDD.
+///
+/// Counts are computed with 128 bits integers and stored in 64 bits. Only the nodes whose count
+/// doesn't fit are computed again with cpp_int, from the counts of their successors.
 template <typename C>
 struct count_combinations_visitor
 {
   /// @brief Required by mem::variant visitor mechanism.
-  using result_type = boost::multiprecision::cpp_int;
-
-  /// @brief How to identify a node.
-  using node_id_type = typename flat_node<C>::id_type;
+  using result_type = combinations;
 
   /// @brief A cache is used to speed up the computation.
-  mutable std::unordered_map<node_id_type, result_type> cache_;
+  mutable combinations_memo cache_;
+
+  /// @brief The counts which don't fit in 64 bits.
+  ///
+  /// A deque doesn't move its elements, the cache refers to them.
+  mutable std::deque<boost::multiprecision::cpp_int> big_counts_;
+
+  /// @brief The cache kept across countings, if any.
+  combinations_cache* persistent_;
+
+  /// @brief Constructor.
+  count_combinations_visitor(combinations_cache* persistent = nullptr)
+    : cache_()
+    , big_counts_()
+    , persistent_(persistent)
+  {}
 
   /// @brief Error case.
   ///
@@ -42,7 +313,7 @@ struct count_combinations_visitor
   operator()(const one_terminal<C>&)
   const noexcept
   {
-    return 1;
+    return {1, nullptr};
   }
 
   /// @brief The number of paths for a flat SDD.
@@ -50,17 +321,52 @@ struct count_combinations_visitor
   operator()(const flat_node<C>& n)
   const
   {
-    const auto insertion = cache_.emplace(n.id(), 0);
-    if (insertion.second)
+    const auto id = n.id();
+    const auto env = id.env.ptr()->id();
+    if (const auto cached = cache_.find(env, id.node))
     {
+      return *cached;
+    }
+    result_type res {0, nullptr};
+    if (persistent_ and persistent_->find(env, id.node, res))
+    {
+      cache_.insert(env, id.node, res);
+      return res;
+    }
+
+    unsigned __int128 sum = 0;
+    bool overflow = false;
+    for (const auto& arc : n)
+    {
+      const auto succ = visit(*this, arc.successor());
+      if (succ.big or __builtin_add_overflow( sum
+                                            , static_cast<unsigned __int128>(size(arc.valuation()))
+                                              * succ.small
+                                            , &sum))
+      {
+        overflow = true;
+        break;
+      }
+    }
+
+    res = {static_cast<std::uint64_t>(sum), nullptr};
+    if (overflow or sum > std::numeric_limits<std::uint64_t>::max())
+    {
+      boost::multiprecision::cpp_int big = 0;
       for (const auto& arc : n)
       {
-        insertion.first->second += size(arc.valuation()) * visit(*this, arc.successor());
+        big += size(arc.valuation()) * visit(*this, arc.successor()).value();
       }
+      big_counts_.push_back(std::move(big));
+      res = {0, &big_counts_.back()};
+    }
+    if (persistent_)
+    {
+      res = persistent_->insert(env, id.node, res);
     }
-    return insertion.first->second;
+    cache_.insert(env, id.node, res);
+    return res;
   }
-
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -68,13 +374,20 @@ struct count_combinations_visitor
 /// @internal
 /// @brief Compute the number of combinations in an SDD.
 ///
-/// O(N) where N is the number of nodes in x.
+/// O(N) where N is the number of nodes in x. When the configuration enables the cache of
+/// combinations, only the nodes which were not counted by a previous call are visited.
 template <typename C>
 inline
 boost::multiprecision::cpp_int
 count_combinations(const SDD<C>& x)
 {
-  return x.empty() ? 0 : visit(count_combinations_visitor<C>(), x);
+  if (x.empty())
+  {
+    return 0;
+  }
+  auto& persistent = global<C>().combinations_cache;
+  return visit( count_combinations_visitor<C>(persistent.enabled() ? &persistent : nullptr), x)
+         .value();
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -13,6 +13,7 @@
 #include "sdd/dd/proto_env.hh"
 #include "sdd/dd/proto_node_fwd.hh"
 #include "sdd/dd/proto_view_fwd.hh"
+#include "sdd/dd/shift_values.hh"
 #include "sdd/dd/terminal.hh"
 #include "sdd/dd/top.hh"
 #include "sdd/mem/ptr.hh"
@@ -331,7 +332,7 @@ public:
   const
   {
     assert(index() == proto_node_index && "Attempt to convert a non-proto_node");
-    return proto_view<C, ptr_type>(env_, mem::variant_cast<proto_node<C>>(ptr_->data()));
+    return proto_view<C, ptr_type>(env_, *ptr_);
   }
 
 private:
@@ -425,16 +426,10 @@ private:
     // Intialize all proto arcs
     for (const auto& sdd_values : builder)
     {
-      typename values::values_traits<values_type>::builder values_builder;
-
       const auto k = C::common(sdd_values.second.cbegin(), sdd_values.second.cend());
-      for (const auto& v : sdd_values.second)
-      {
-        values_builder.insert(C::shift(v, k));
-      }
 
       // Construct arc of the proto_dd.
-      arcs.emplace_back( values_type(std::move(values_builder))
+      arcs.emplace_back( dd::shift_values<C>(sdd_values.second, k)
                        , push(sdd_values.first.env().values_stack(), k)
                        , push( sdd_values.first.env().successors_stack()
                              , sdd_values.first.ptr()
@@ -466,7 +461,8 @@ private:
     // Shift stacks on proto arcs with the new environments' stacks
     for (auto& proto_arc : arcs)
     {
-      proto_arc.values.shift(env_value_stack, C::shift);
+      proto_arc.values.shift( env_value_stack
+                            , [](value_type v, value_type k){return C::shift(v, k);});
       proto_arc.successors.shift(env_succs_stack, [](const ptr_type& lhs, const ptr_type& rhs)
                                                     {
                                                       return rhs == zero_ptr() ? lhs : zero_ptr();
@@ -517,7 +513,8 @@ noexcept
 /// @brief   Comparison of two SDD.
 /// @related SDD
 ///
-/// O(1). The order of SDD is arbitrary and can change at each run.
+/// O(1). The order of SDD is arbitrary, but it's the same at each run as it follows the order
+/// in which SDD are unified.
 template <typename C>
 inline
 bool
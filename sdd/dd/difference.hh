@@ -56,7 +56,7 @@ struct difference_visitor
     // Compute union of all rhs valuations.
     sum_builder<C, typename C::Values> sum_builder;
     sum_builder.reserve(rhs.size());
-    for (auto& rhs_arc : rhs)
+    for (const auto& rhs_arc : rhs)
     {
       sum_builder.add(rhs_arc.valuation());
     }
@@ -69,7 +69,7 @@ struct difference_visitor
     su.reserve(lhs.size() * 2);
 
     // For each valuation of lhs, remove the quantity rhs_union.
-    for (auto& lhs_arc : lhs)
+    for (const auto& lhs_arc : lhs)
     {
       typename C::Values tmp = difference(cxt_, lhs_arc.valuation(), rhs_union);
       if (not values::empty_values(tmp))
@@ -79,9 +79,9 @@ struct difference_visitor
     }
 
     // For all common parts, propagate the difference on succcessors.
-    for (auto& lhs_arc : lhs)
+    for (const auto& lhs_arc : lhs)
     {
-      for (auto& rhs_arc : rhs)
+      for (const auto& rhs_arc : rhs)
       {
         intersection_builder<C, typename C::Values> inter_builder;
         inter_builder.add(lhs_arc.valuation());
@@ -59,9 +59,9 @@ struct LIBSDD_ATTRIBUTE_PACKED intersection_op_impl
       const auto lhs = res.view();
       const auto rhs = operands_cit->view();
 
-      for (auto& lhs_arc : lhs)
+      for (const auto& lhs_arc : lhs)
       {
-        for (auto& rhs_arc : rhs)
+        for (const auto& rhs_arc : rhs)
         {
           intersection_builder<C, valuation_type> valuation_builder;
           valuation_builder.add(lhs_arc.valuation());
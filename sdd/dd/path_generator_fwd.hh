@@ -1,11 +1,12 @@
-#if !defined(HAS_NO_BOOST_COROUTINE)
 #ifndef _SDD_DD_PATH_GENERATOR_FWD_HH_
 #define _SDD_DD_PATH_GENERATOR_FWD_HH_
 
 #include <memory>
 #include <vector>
 
+#if !defined(HAS_NO_BOOST_COROUTINE)
 #include <boost/coroutine/coroutine.hpp>
+#endif
 
 #include "sdd/dd/definition_fwd.hh"
 
@@ -19,6 +20,8 @@ namespace sdd {
 template <typename C>
 using path = std::vector<typename C::Values>;
 
+#if !defined(HAS_NO_BOOST_COROUTINE)
+
 /// @brief An on-the-fly generator of all paths contained in an SDD.
 ///
 /// Iterators on it return a const path<C>&.
@@ -51,7 +54,10 @@ paths(typename path_generator<C>::caller_type&, const SDD<C>&);
 
 /*------------------------------------------------------------------------------------------------*/
 
-}} // namespace sdd::dd
+} // namespace dd
 
-#endif // _SDD_DD_PATH_GENERATOR_FWD_HH_
 #endif // !defined(HAS_NO_BOOST_COROUTINE)
+
+} // namespace sdd
+
+#endif // _SDD_DD_PATH_GENERATOR_FWD_HH_
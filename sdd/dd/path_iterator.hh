@@ -0,0 +1,252 @@
+#ifndef _SDD_DD_PATH_ITERATOR_HH_
+#define _SDD_DD_PATH_ITERATOR_HH_
+
+#include <cstddef>       // size_t
+#include <unordered_map>
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "sdd/dd/definition.hh"
+#include "sdd/dd/path_generator_fwd.hh"
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Enumerate all paths of an SDD, one at a time.
+///
+/// Paths are enumerated in the order of arcs, as with SDD::paths(). A single path is updated in
+/// place: moving to the next path only rewrites the levels below the last changed arc. The
+/// nodes of the current path are kept on an explicit stack, thus no coroutine is needed.
+///
+/// Unlike SDD::paths(), |0| has no path.
+template <typename C>
+class path_iterator final
+{
+  // Can't copy a path_iterator: frames refer to themselves.
+  path_iterator(const path_iterator&) = delete;
+  path_iterator& operator=(const path_iterator&) = delete;
+
+public:
+
+  /// @brief The type of a path.
+  using path_type = path<C>;
+
+  /// @brief The type of an index or a number of paths.
+  using count_type = boost::multiprecision::cpp_int;
+
+private:
+
+  /// @brief A node of the current path and its arc on this path.
+  struct frame
+  {
+    flat_node<C> view;
+    typename flat_node<C>::const_iterator cit;
+
+    frame(const SDD<C>& x)
+      : view(x.view())
+      , cit(view.begin())
+    {}
+  };
+
+  /// @brief The enumerated SDD.
+  const SDD<C> root_;
+
+  /// @brief The nodes of the current path, from the top to the bottom.
+  ///
+  /// Its capacity is the height of the SDD, so frames never move.
+  std::vector<frame> frames_;
+
+  /// @brief The current path.
+  path_type path_;
+
+  /// @brief Tell if all paths have been enumerated.
+  bool done_;
+
+  /// @brief The index of the current path.
+  count_type index_;
+
+  /// @brief The number of paths of already visited nodes, to skip paths.
+  std::unordered_map<typename flat_node<C>::id_type, count_type> counts_;
+
+public:
+
+  /// @brief Constructor.
+  ///
+  /// O(h) where h is the height of x.
+  explicit path_iterator(const SDD<C>& x)
+    : root_(x)
+    , frames_()
+    , path_()
+    , done_(x.empty())
+    , index_(0)
+    , counts_()
+  {
+    const std::size_t height = x.index() == SDD<C>::proto_node_index ? x.env().level() : 0;
+    frames_.reserve(height);
+    path_.resize(height);
+    if (not done_)
+    {
+      descend(root_);
+    }
+  }
+
+  /// @brief Tell if all paths have been enumerated.
+  bool
+  done()
+  const noexcept
+  {
+    return done_;
+  }
+
+  /// @brief Get the current path.
+  ///
+  /// The returned reference is updated when the iterator moves.
+  const path_type&
+  operator*()
+  const noexcept
+  {
+    return path_;
+  }
+
+  /// @brief Get the current path.
+  const path_type*
+  operator->()
+  const noexcept
+  {
+    return &path_;
+  }
+
+  /// @brief Get the index of the current path.
+  const count_type&
+  index()
+  const noexcept
+  {
+    return index_;
+  }
+
+  /// @brief Move to the next path.
+  path_iterator&
+  operator++()
+  {
+    ++index_;
+    while (not frames_.empty())
+    {
+      auto& f = frames_.back();
+      ++f.cit;
+      if (f.cit != f.view.end())
+      {
+        const auto arc = *f.cit;
+        path_[frames_.size() - 1] = arc.valuation();
+        descend(arc.successor());
+        return *this;
+      }
+      frames_.pop_back();
+    }
+    done_ = true;
+    return *this;
+  }
+
+  /// @brief Copy up to n paths to out, and move after them.
+  /// @return The number of copied paths, lower than n only when all paths have been enumerated.
+  ///
+  /// Paths of out are assigned, thus the memory they already hold is reused.
+  std::size_t
+  next(path_type* out, std::size_t n)
+  {
+    std::size_t i = 0;
+    for (; i < n and not done_; ++i)
+    {
+      out[i] = path_;
+      ++*this;
+    }
+    return i;
+  }
+
+  /// @brief Skip n paths.
+  ///
+  /// The number of paths below each node is computed once, then only one path from the root is
+  /// visited.
+  void
+  skip(const count_type& n)
+  {
+    seek(index_ + n);
+  }
+
+  /// @brief Move to the path of a given index.
+  void
+  seek(count_type i)
+  {
+    frames_.clear();
+    index_ = i;
+    if (root_.empty() or i >= count(root_))
+    {
+      done_ = true;
+      return;
+    }
+    done_ = false;
+    for (auto x = root_; x.index() == SDD<C>::proto_node_index;)
+    {
+      frames_.emplace_back(x);
+      auto& f = frames_.back();
+      for (;; ++f.cit)
+      {
+        // Dereferencing the iterator decodes the arc, thus it's done once per step.
+        const auto arc = *f.cit;
+        const auto& c = count(arc.successor());
+        if (i < c)
+        {
+          path_[frames_.size() - 1] = arc.valuation();
+          x = arc.successor();
+          break;
+        }
+        i -= c;
+      }
+    }
+  }
+
+private:
+
+  /// @brief Push the first path of x.
+  void
+  descend(SDD<C> x)
+  {
+    while (x.index() == SDD<C>::proto_node_index)
+    {
+      frames_.emplace_back(x);
+      const auto arc = *frames_.back().cit;
+      path_[frames_.size() - 1] = arc.valuation();
+      x = arc.successor();
+    }
+  }
+
+  /// @brief Get the number of paths of a non-empty SDD.
+  const count_type&
+  count(const SDD<C>& x)
+  {
+    static const count_type one = 1;
+    if (x.index() != SDD<C>::proto_node_index)
+    {
+      return one;
+    }
+    const auto view = x.view();
+    const auto search = counts_.find(view.id());
+    if (search != counts_.end())
+    {
+      return search->second;
+    }
+    count_type res = 0;
+    for (const auto& arc : view)
+    {
+      res += count(arc.successor());
+    }
+    return counts_.emplace(view.id(), std::move(res)).first->second;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
+
+#endif // _SDD_DD_PATH_ITERATOR_HH_
@@ -1,14 +1,19 @@
 #ifndef _SDD_DD_PROTO_VIEW_HH_
 #define _SDD_DD_PROTO_VIEW_HH_
 
+#include <cstdint> // uint64_t
 #include <memory>
 #include <vector>
 
+#include <boost/iterator/iterator_facade.hpp>
+
 #include "sdd/internal_manager_fwd.hh"
 #include "sdd/dd/alpha.hh"
 #include "sdd/dd/definition.hh"
 #include "sdd/dd/proto_env.hh"
 #include "sdd/dd/proto_node.hh"
+#include "sdd/dd/shift_values.hh"
+#include "sdd/util/concurrency.hh"
 
 namespace sdd {
 
@@ -22,12 +27,16 @@ struct proto_view_identity
   using env_type = dd::proto_env<C, Successor>;
 
   const env_type env;
-  const char* node;
 
-  proto_view_identity(const env_type& env, const proto_node<C>& node)
+  /// @brief The unification identifier of the SDD holding the node.
+  ///
+  /// It doesn't depend on the address of the node and is never given to another node.
+  const std::uint64_t node;
+
+  proto_view_identity(const env_type& env, const sdd_unique_type<C>& unique)
   noexcept
     : env(env)
-    , node(reinterpret_cast<const char*>(&node))
+    , node(unique.id())
   {}
 
   bool
@@ -52,12 +61,51 @@ struct dummy_error
   {}
 };
 
+/// @internal
+/// @brief Decode a single arc of a proto_node in a given environment.
+template <typename C, typename Successor>
+arc<C, typename C::Values>
+mk_arc(const dd::proto_env<C, Successor>& env, const proto_arc<C>& proto_arc)
+{
+  using values_type = typename C::Values;
+  using value_type = typename values_type::value_type;
+  using env_type = dd::proto_env<C, Successor>;
+
+  assert((env.level() - 1) < env.level() && "Overflow");
+
+  // Rebuild the stacks needed to construct this arc.
+  auto values_stack = proto_arc.values;
+  values_stack.rebuild( env.values_stack()
+                      , [](value_type v, value_type k){return C::rebuild(v, k);});
+
+  auto succs_stack = proto_arc.successors;
+  succs_stack.rebuild( env.successors_stack()
+                     , [](const Successor& lhs, const Successor& rhs)
+                         {
+                           return rhs == dd::default_value<Successor>::value() ? lhs : rhs;
+                         });
+
+  // Get the values of the current level.
+  const auto k = head(values_stack);
+
+  // Get the successor of the current level.
+  const auto succ = head(succs_stack);
+
+  // The current arc is complete.
+  return arc<C, values_type>( dd::rebuild_values<C>(proto_arc.current_values, k)
+                            , SDD<C>(succ, env_type( env.level() - 1
+                                                   , std::move(values_stack.pop())
+                                                   , std::move(succs_stack.pop()))));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 template <typename C, typename Successor>
 struct mk_arcs_op
 {
   using values_type = typename C::Values;
-  using value_type = typename C::Values::value_type;
+  using value_type = typename values_type::value_type;
   using env_type = dd::proto_env<C, Successor>;
   using arc_type = arc<C, values_type>;
   using arcs_type = std::vector<arc_type>;
@@ -67,61 +115,35 @@ struct mk_arcs_op
   const env_type env;
   const proto_node<C>& node;
 
-  mk_arcs_op(const env_type e, const proto_node<C>& n)
-    : env(e), node(n)
+  /// @brief The unification identifier of the SDD holding node.
+  ///
+  /// An entry of the cache may outlive its node, whose address can then be reused by another
+  /// node. Thus, node is only accessed when the arcs are built.
+  const std::uint64_t id;
+
+  mk_arcs_op(const env_type e, const sdd_unique_type<C>& u)
+    : env(e), node(mem::variant_cast<proto_node<C>>(u.data())), id(u.id())
   {}
 
   bool
   operator==(const mk_arcs_op& other)
   const noexcept
   {
-    return env == other.env and &node == &other.node;
+    return env == other.env and id == other.id;
   }
 
   result_type
   operator()(dummy_context&)
   const
   {
-    assert((env.level() - 1) < env.level() && "Overflow");
     assert(node.size() >= 1 && "Empty proto_node");
 
     auto arcs_ptr = std::make_shared<arcs_type>();
     auto& arcs = *arcs_ptr;
     arcs.reserve(node.size());
-
-    // A buffer of values reused for each arc.
-    static std::vector<value_type> values_buffer;
-
     for (const auto& proto_arc : node)
     {
-      // Rebuild the stacks needed to construct this arc.
-      auto values_stack = proto_arc.values;
-      values_stack.rebuild(env.values_stack(), C::rebuild);
-
-      auto succs_stack = proto_arc.successors;
-      succs_stack.rebuild( env.successors_stack()
-                         , [](const Successor& lhs, const Successor& rhs)
-                             {
-                               return rhs == dd::default_value<Successor>::value() ? lhs : rhs;
-                             });
-
-      // Get the values of the current level.
-      const auto k = head(values_stack);
-      std::transform( proto_arc.current_values.cbegin(), proto_arc.current_values.cend()
-                    , std::back_inserter(values_buffer)
-                    , [&](value_type v){return C::rebuild(v, k);});
-
-      // Get the successor of the current level.
-      const auto succ = head(succs_stack);
-
-      // The current arc is complete.
-      arcs.emplace_back( values_type(values_buffer.cbegin(), values_buffer.cend())
-                       , SDD<C>(succ, env_type( env.level() - 1
-                                              , std::move(values_stack.pop())
-                                              , std::move(succs_stack.pop()))));
-
-      // Will be re-used on next iteration.
-      values_buffer.clear();
+      arcs.emplace_back(mk_arc(env, proto_arc));
     }
     return arcs_ptr;
   }
@@ -129,6 +151,78 @@ struct mk_arcs_op
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief A single-pass iterator on the arcs of a proto_view.
+///
+/// When the view has not materialized its arcs, each arc is decoded from the proto_node only when
+/// the iterator is dereferenced. Arcs are thus returned by value: there is no storage which would
+/// outlive the iterator to refer to.
+template <typename View>
+class proto_view_iterator
+  : public boost::iterator_facade< proto_view_iterator<View>
+                                 , const typename View::arc_type, boost::single_pass_traversal_tag
+                                 , typename View::arc_type>
+{
+private:
+
+  /// @brief The iterated view.
+  const View* view_;
+
+  /// @brief The position of the current arc.
+  std::size_t pos_;
+
+public:
+
+  /// @brief Default constructor.
+  proto_view_iterator()
+  noexcept
+    : view_(nullptr)
+    , pos_(0)
+  {}
+
+  /// @brief Constructor.
+  proto_view_iterator(const View* view, std::size_t pos)
+  noexcept
+    : view_(view)
+    , pos_(pos)
+  {}
+
+private:
+
+  // Required by boost::iterator.
+  friend class boost::iterator_core_access;
+
+  /// @brief For boost::iterator.
+  void
+  increment()
+  noexcept
+  {
+    ++pos_;
+  }
+
+  /// @brief For boost::iterator.
+  bool
+  equal(const proto_view_iterator& other)
+  const noexcept
+  {
+    return pos_ == other.pos_;
+  }
+
+  /// @brief For boost::iterator.
+  typename View::arc_type
+  dereference()
+  const
+  {
+    if (view_->arcs_)
+    {
+      return (*view_->arcs_)[pos_];
+    }
+    return mk_arc(view_->env_, *(view_->node().begin() + pos_));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 template <typename C, typename Successor>
 class proto_view final
@@ -137,6 +231,9 @@ class proto_view final
   proto_view& operator=(const proto_view&) = delete;
   proto_view(const proto_view&) = delete;
 
+  // Iterators decode arcs from the proto_node.
+  friend class proto_view_iterator<proto_view>;
+
 public:
 
   using values_type = typename C::Values;
@@ -151,7 +248,7 @@ public:
   using variable_type = typename C::variable_type;
 
   /// @brief A (const) iterator on the arcs of this node.
-  using const_iterator = typename arcs_type::const_iterator;
+  using const_iterator = proto_view_iterator<proto_view>;
 
   using id_type = proto_view_identity<C, Successor>;
 
@@ -162,20 +259,27 @@ private:
   /// A shared pointer behind the scene.
   const env_type env_;
 
-  /// @brief Store the temporary arcs of this view.
-//  const arcs_type arcs_;
-  const std::shared_ptr<arcs_type> arcs_;
+  /// @brief Keep the unified SDD of the original proto_node for identifications purposes.
+  const sdd_unique_type<C>& unique_;
 
-  /// @brief Keep the original proto_node for identifications purposes.
-  const proto_node<C>& node_;
+  /// @brief All the arcs of this view, once materialized.
+  ///
+  /// A first traversal decodes arcs one at a time, which is enough for operations that stop
+  /// early. As soon as the view is traversed again, all its arcs are fetched from the
+  /// proto_arcs_cache to avoid decoding them once per traversal.
+  mutable std::shared_ptr<arcs_type> arcs_;
+
+  /// @brief Tell if a traversal has already been started.
+  mutable bool traversed_;
 
 public:
 
-  proto_view(const env_type& env, const proto_node<C>& node)
+  proto_view(const env_type& env, const sdd_unique_type<C>& unique)
   noexcept
     : env_(env)
-    , arcs_(global<C>().proto_arcs_cache(mk_arcs_op<C, Successor>(env, node)))
-    , node_(node)
+    , unique_(unique)
+    , arcs_()
+    , traversed_(false)
   {}
 
   // Move a proto_view.
@@ -194,12 +298,17 @@ public:
 
   /// @brief Get the beginning of arcs.
   ///
-  /// O(1).
+  /// O(1) for the first traversal; materialize all arcs for the following ones.
   const_iterator
   begin()
-  const noexcept
+  const
   {
-    return arcs_->cbegin();
+    if (traversed_)
+    {
+      materialize();
+    }
+    traversed_ = true;
+    return const_iterator(this, 0);
   }
 
   /// @brief Get the end of arcs.
@@ -209,17 +318,29 @@ public:
   end()
   const noexcept
   {
-    return arcs_->cend();
+    return const_iterator(this, node().size());
   }
 
   /// @brief Get the number of arcs.
   ///
-  /// O(1).
+  /// O(1), doesn't decode any arc.
   std::size_t
   size()
   const noexcept
   {
-    return arcs_->size();
+    return node().size();
+  }
+
+  /// @brief Get all arcs of this view at once.
+  ///
+  /// They are decoded only once for all views of the same proto_node in the same environment,
+  /// until they are evicted from the proto_arcs_cache.
+  const arcs_type&
+  arcs()
+  const
+  {
+    materialize();
+    return *arcs_;
   }
 
   /// @brief Get an value that uniquely identify any proto_view created with the same environment
@@ -228,18 +349,43 @@ public:
   id()
   const noexcept
   {
-    return proto_view_identity<C, Successor>(env_, node_);
+    return proto_view_identity<C, Successor>(env_, unique_);
+  }
+
+private:
+
+  /// @brief Get the original proto_node.
+  ///
+  /// O(1).
+  const proto_node<C>&
+  node()
+  const noexcept
+  {
+    return mem::variant_cast<proto_node<C>>(unique_.data());
+  }
+
+  /// @brief Fetch all arcs of this view from the proto_arcs_cache, if not already done.
+  void
+  materialize()
+  const
+  {
+    if (not arcs_)
+    {
+      arcs_ = global<C>().proto_arcs_cache(mk_arcs_op<C, Successor>(env_, unique_));
+    }
   }
 };
 
 /*------------------------------------------------------------------------------------------------*/
 
-template <typename C, typename Successor>
+/// @internal
+/// @brief Get the view of the proto_node held by a visited SDD.
+template <typename C>
 inline
-proto_view<C, Successor>
-view(const proto_node<C>& n, const dd::proto_env<C, Successor>& env)
+proto_view<C, sdd_ptr_type<C>>
+view(const proto_node<C>&, const SDD<C>& x)
 {
-  return {env, n};
+  return x.view();
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -290,8 +436,8 @@ struct hash<sdd::mk_arcs_op<C, Successor>>
   operator()(const sdd::mk_arcs_op<C, Successor>& op)
   const noexcept
   {
-    std::size_t seed = sdd::util::hash(&*op.env);
-    sdd::util::hash_combine(seed, &op.node);
+    std::size_t seed = sdd::util::hash(op.env);
+    sdd::util::hash_combine(seed, op.id);
     return seed;
   }
 };
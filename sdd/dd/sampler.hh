@@ -0,0 +1,233 @@
+#ifndef _SDD_DD_SAMPLER_HH_
+#define _SDD_DD_SAMPLER_HH_
+
+#include <algorithm>  // partition_point, sort
+#include <cstdint>    // uint32_t
+#include <iterator>   // next
+#include <random>     // uniform_int_distribution
+#include <stdexcept>  // out_of_range
+#include <utility>    // pair
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "sdd/dd/count_combinations.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/values/size.hh"
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Draw elements of an SDD uniformly at random, without enumerating them.
+///
+/// Elements are numbered from 0 to the number of combinations of the SDD. An element is found
+/// from its index by walking down the SDD: at each node, an arc and then one of its values are
+/// chosen according to the number of combinations below them. These numbers are computed once
+/// per node by a count_combinations_visitor, whose cache is kept by the sampler.
+template <typename C>
+class sampler final
+{
+public:
+
+  /// @brief The type of an index or a number of elements.
+  using count_type = boost::multiprecision::cpp_int;
+
+  /// @brief The type of an element: one value per level, from the top to the bottom.
+  using sample_type = std::vector<typename C::Values::value_type>;
+
+private:
+
+  /// @brief An index to find and the position of its element in the result.
+  using request_type = std::pair<count_type, std::size_t>;
+
+  /// @brief The sampled SDD.
+  const SDD<C> root_;
+
+  /// @brief Count elements below nodes, and cache these numbers.
+  const dd::count_combinations_visitor<C> counter_;
+
+  /// @brief The number of elements of the SDD.
+  const count_type size_;
+
+  /// @brief The number of levels of the SDD.
+  const std::size_t height_;
+
+public:
+
+  /// @brief Constructor.
+  ///
+  /// O(N) where N is the number of nodes of x.
+  explicit sampler(const SDD<C>& x)
+    : root_(x)
+    , counter_()
+    , size_(x.empty() ? count_type(0) : visit(counter_, x).value())
+    , height_(x.index() == SDD<C>::proto_node_index ? x.env().level() : 0)
+  {}
+
+  /// @brief Get the number of elements of the sampled SDD.
+  const count_type&
+  size()
+  const noexcept
+  {
+    return size_;
+  }
+
+  /// @brief Get the element of a given index.
+  /// @throw std::out_of_range if the index is not lower than size().
+  ///
+  /// O(h * (a + v)) where h is the height of the SDD, a the number of arcs of its largest node and
+  /// v the size of its largest set of values: at each level, arcs are scanned linearly and the
+  /// chosen value is reached by iterating over its set.
+  sample_type
+  at(const count_type& index)
+  const
+  {
+    std::vector<sample_type> res(1);
+    std::vector<request_type> requests {request_type(index, 0)};
+    find(requests, res);
+    return std::move(res.front());
+  }
+
+  /// @brief Draw an element uniformly at random.
+  /// @throw std::out_of_range if the SDD is empty.
+  template <typename URBG>
+  sample_type
+  operator()(URBG& generator)
+  const
+  {
+    return at(random_index(generator));
+  }
+
+  /// @brief Draw k elements uniformly at random and independently.
+  /// @throw std::out_of_range if the SDD is empty and k is not 0.
+  ///
+  /// All elements are found in a single traversal: a node common to several of them is visited
+  /// once. Elements are returned in the order they were drawn.
+  template <typename URBG>
+  std::vector<sample_type>
+  operator()(URBG& generator, std::size_t k)
+  const
+  {
+    std::vector<sample_type> res(k);
+    std::vector<request_type> requests;
+    requests.reserve(k);
+    for (std::size_t i = 0; i < k; ++i)
+    {
+      requests.emplace_back(random_index(generator), i);
+    }
+    find(requests, res);
+    return res;
+  }
+
+private:
+
+  /// @brief Draw an index uniformly in [0, size()).
+  template <typename URBG>
+  count_type
+  random_index(URBG& generator)
+  const
+  {
+    if (size_ == 0)
+    {
+      throw std::out_of_range("Can't sample an empty SDD.");
+    }
+    // Draw as many bits as needed by size_ - 1 and reject values which are too large; at least
+    // half of the draws are accepted.
+    const auto bits = size_ == 1 ? 0 : boost::multiprecision::msb(count_type(size_ - 1)) + 1;
+    std::uniform_int_distribution<std::uint32_t> chunk;
+    while (true)
+    {
+      count_type res = 0;
+      for (std::size_t drawn = 0; drawn < bits; drawn += 32)
+      {
+        res <<= 32;
+        res |= chunk(generator);
+      }
+      res &= (count_type(1) << bits) - 1;
+      if (res < size_)
+      {
+        return res;
+      }
+    }
+  }
+
+  /// @brief Find the elements of all requested indices.
+  void
+  find(std::vector<request_type>& requests, std::vector<sample_type>& res)
+  const
+  {
+    for (const auto& request : requests)
+    {
+      if (request.first >= size_)
+      {
+        throw std::out_of_range("Index of element out of range.");
+      }
+      res[request.second].resize(height_);
+    }
+    std::sort( requests.begin(), requests.end()
+             , [](const request_type& lhs, const request_type& rhs)
+                 {
+                   return lhs.first < rhs.first;
+                 });
+    find(root_, 0, requests.begin(), requests.end(), res);
+  }
+
+  /// @brief Find the elements of sorted indices, relative to x.
+  void
+  find( const SDD<C>& x, std::size_t level
+      , typename std::vector<request_type>::iterator begin
+      , typename std::vector<request_type>::iterator end
+      , std::vector<sample_type>& res)
+  const
+  {
+    if (begin == end or x.index() != SDD<C>::proto_node_index)
+    {
+      return;
+    }
+    count_type offset = 0;
+    for (const auto& arc : x.view())
+    {
+      const auto succ = arc.successor();
+      const count_type succ_size = visit(counter_, succ).value();
+      const count_type arc_offset = offset;
+      offset += values::size(arc.valuation()) * succ_size;
+      // Requests whose element goes through this arc.
+      const auto arc_end = std::partition_point( begin, end
+                                               , [&](const request_type& r)
+                                                   {
+                                                     return r.first < offset;
+                                                   });
+      while (begin != arc_end)
+      {
+        // Requests whose element goes through the same value.
+        const auto nth = static_cast<std::size_t>((begin->first - arc_offset) / succ_size);
+        const count_type value_offset = arc_offset + nth * succ_size;
+        const count_type value_end = value_offset + succ_size;
+        const auto value = *std::next(arc.valuation().begin(), nth);
+        const auto group_end = std::partition_point( begin, arc_end
+                                                   , [&](const request_type& r)
+                                                       {
+                                                         return r.first < value_end;
+                                                       });
+        for (auto cit = begin; cit != group_end; ++cit)
+        {
+          res[cit->second][level] = value;
+          cit->first -= value_offset;
+        }
+        find(succ, level + 1, begin, group_end, res);
+        begin = group_end;
+      }
+      if (begin == end)
+      {
+        return;
+      }
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
+
+#endif // _SDD_DD_SAMPLER_HH_
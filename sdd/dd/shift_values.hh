@@ -0,0 +1,95 @@
+#ifndef _SDD_DD_SHIFT_VALUES_HH_
+#define _SDD_DD_SHIFT_VALUES_HH_
+
+#include <utility> // move
+#include <vector>
+
+#include "sdd/util/concurrency.hh"
+#include "sdd/values/values_traits.hh"
+
+namespace sdd { namespace dd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Called when the configuration shifts a whole set of values at once.
+template <typename C>
+auto
+shift_values_impl(const typename C::Values& values, typename C::Values::value_type k, int)
+-> decltype(C::shift(values, k))
+{
+  return C::shift(values, k);
+}
+
+/// @internal
+/// @brief Called when the configuration only shifts values one by one.
+template <typename C>
+typename C::Values
+shift_values_impl(const typename C::Values& values, typename C::Values::value_type k, long)
+{
+  typename values::values_traits<typename C::Values>::builder builder;
+  for (const auto& v : values)
+  {
+    builder.insert(C::shift(v, k));
+  }
+  return typename C::Values(std::move(builder));
+}
+
+/// @internal
+/// @brief Shift all values of a set by k, when it's encoded in a proto node.
+///
+/// A configuration may overload C::shift for its set of values, e.g. to shift all intervals of
+/// an interval_set rather than all its values.
+template <typename C>
+typename C::Values
+shift_values(const typename C::Values& values, typename C::Values::value_type k)
+{
+  // Static dispatch.
+  return shift_values_impl<C>(values, k, 0);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Called when the configuration rebuilds a whole set of values at once.
+template <typename C>
+auto
+rebuild_values_impl(const typename C::Values& values, typename C::Values::value_type k, int)
+-> decltype(C::rebuild(values, k))
+{
+  return C::rebuild(values, k);
+}
+
+/// @internal
+/// @brief Called when the configuration only rebuilds values one by one.
+template <typename C>
+typename C::Values
+rebuild_values_impl(const typename C::Values& values, typename C::Values::value_type k, long)
+{
+  using value_type = typename C::Values::value_type;
+
+  // A buffer of values reused for each call.
+  static LIBSDD_THREAD_LOCAL std::vector<value_type> buffer;
+  buffer.clear();
+  for (const auto& v : values)
+  {
+    buffer.push_back(C::rebuild(v, k));
+  }
+  return typename C::Values(buffer.cbegin(), buffer.cend());
+}
+
+/// @internal
+/// @brief Rebuild all values of a set shifted by k, when it's decoded from a proto node.
+template <typename C>
+typename C::Values
+rebuild_values(const typename C::Values& values, typename C::Values::value_type k)
+{
+  // Static dispatch.
+  return rebuild_values_impl<C>(values, k, 0);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::dd
+
+#endif // _SDD_DD_SHIFT_VALUES_HH_
@@ -2,19 +2,35 @@
 #define _SDD_DD_STACK_HH_
 
 #include <algorithm>
+#include <iterator>    // make_move_iterator, next
+#include <new>         // placement new
+#include <type_traits> // is_nothrow_move_constructible
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "sdd/dd/default_value.hh"
+#include "sdd/util/concurrency.hh"
 #include "sdd/util/hash.hh"
 
 namespace sdd { namespace dd {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief A stack whose first elements are stored inline.
+///
+/// Stacks are usually short: the ones of at most inline_size elements don't allocate any memory.
 template <typename T>
 struct stack
 {
-  std::vector<T> elements;
+  /// @brief The number of elements stored without allocating memory.
+  static constexpr std::size_t inline_size = 2;
+
+  /// @brief The type of the container of elements.
+  using elements_type = boost::container::small_vector<T, inline_size>;
+
+  elements_type elements;
 
   T
   operator[] (std::size_t i) const
@@ -65,16 +81,15 @@ template <typename T>
 stack<T>
 push (const stack<T>& s, const T& e)
 {
-  if (s.elements.empty() && (e == default_value<T>::value()))
-    return s;
-  else
+  // A single named result, constructed in place by the caller: pushing a default value on an
+  // empty stack gives an empty stack.
+  stack<T> result;
+  if (not s.elements.empty() or not (e == default_value<T>::value()))
   {
-    stack<T> result;
-    result.elements.reserve(s.elements.size() + 1);
-    result.elements.push_back(e);
-    std::copy(s.elements.cbegin(), s.elements.cend(), std::back_inserter(result.elements));
-    return result;
+    result.elements.resize(s.elements.size() + 1, e);
+    std::copy(s.elements.cbegin(), s.elements.cend(), std::next(result.elements.begin()));
   }
+  return result;
 }
 
 template <typename T>
@@ -114,7 +129,29 @@ canonize (stack<T>& s)
     else
       break;
   }
-  s.elements.shrink_to_fit();
+  // Give back unused memory.
+  if (s.elements.capacity() > stack<T>::inline_size and s.elements.capacity() > s.elements.size())
+  {
+    using elements_type = typename stack<T>::elements_type;
+    elements_type tmp( std::make_move_iterator(s.elements.begin())
+                     , std::make_move_iterator(s.elements.end()));
+    if (tmp.size() > stack<T>::inline_size)
+    {
+      // tmp has allocated exactly what it needs, its buffer is taken.
+      s.elements.swap(tmp);
+    }
+    else
+    {
+      // Neither small_vector::shrink_to_fit() nor its swap and assignments move elements back to
+      // the inline storage, thus a new container is constructed in place. Its elements fit
+      // inline, so it doesn't allocate and can't throw.
+      static_assert( std::is_nothrow_move_constructible<T>::value
+                   , "Elements must be moved back inline without throwing.");
+      s.elements.~elements_type();
+      new (&s.elements) elements_type( std::make_move_iterator(tmp.begin())
+                                     , std::make_move_iterator(tmp.end()));
+    }
+  }
   return s;
 }
 
@@ -127,7 +164,7 @@ common (const std::vector<std::reference_wrapper<const stack<T>>>& ss, Common&&
     max_size = std::max(max_size, size(s.get()));
   stack<T> result;
   result.elements.reserve(max_size);
-  static std::vector<T> values;
+  static LIBSDD_THREAD_LOCAL std::vector<T> values;
   for (std::size_t i = 0; i != max_size; ++i)
   {
     for (const auto& s : ss)
@@ -195,4 +232,4 @@ struct hash<sdd::dd::stack<T>>
 
 } // namespace std
 
-#endif // _SDD_DD_SPARSE_STACK_HH_
+#endif // _SDD_DD_STACK_HH_
@@ -247,11 +247,28 @@ struct LIBSDD_ATTRIBUTE_PACKED sum_op_impl
       }
     }
 
+#if defined LIBSDD_THREAD_SAFE
+    // The unions of successors are independent, they are forked as tasks on the workers.
+    std::vector<SDD<C>> succs(value_to_succ.size(), zero<C>());
+    auto& m = global<C>();
+    m.workers.parallel_for( value_to_succ.size(), m.sum_grain_size
+                          , [&](std::size_t i)
+                               {
+                                 auto& value_succs = *(value_to_succ.begin() + i);
+                                 succs[i] = sum(cxt, std::move(value_succs.second));
+                               });
+    auto succ_cit = succs.cbegin();
+#endif
+
     boost::container::flat_map<SDD<C>, values_builder> succ_to_value;
     succ_to_value.reserve(value_to_succ.size());
     for (auto& value_succs : value_to_succ)
     {
+#if defined LIBSDD_THREAD_SAFE
+      const SDD<C> succ = *succ_cit++;
+#else
       const SDD<C> succ = sum(cxt, std::move(value_succs.second));
+#endif
       const auto search = succ_to_value.find(succ);
       if (search == succ_to_value.end())
       {
@@ -0,0 +1,351 @@
+#ifndef _SDD_HOM_COMPILE_HH_
+#define _SDD_HOM_COMPILE_HH_
+
+#include <deque>
+#include <iterator> // next
+
+#include "sdd/internal_manager_fwd.hh"
+#include "sdd/hom/context.hh" // must come first, it defines homomorphism_traits
+#include "sdd/hom/common_types.hh"
+#include "sdd/hom/composition.hh"
+#include "sdd/hom/constant.hh"
+#include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/evaluation_error.hh"
+#include "sdd/hom/fixpoint.hh"
+#include "sdd/hom/interrupt.hh"
+#include "sdd/hom/intersection.hh"
+#include "sdd/hom/local.hh"
+#include "sdd/hom/rewrite.hh"
+#include "sdd/hom/saturation_fixpoint.hh"
+#include "sdd/hom/saturation_intersection.hh"
+#include "sdd/hom/saturation_sum.hh"
+#include "sdd/hom/sum.hh"
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Forward declaration for recursive call by compiler.
+template <typename C>
+homomorphism<C>
+compile(const order<C>&, const homomorphism<C>&);
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Forward declaration for recursive call by compiler.
+template <typename C>
+homomorphism<C>
+compile_rewritten(const order<C>&, const homomorphism<C>&);
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Concrete implementation of the compilation process.
+///
+/// It simplifies an already rewritten homomorphism for a given order, so that its evaluation
+/// needs less dispatching and less cache lookups:
+/// - chains of compositions are flattened, then rebuilt in a canonical right-nested form;
+/// - what is applied after a constant is evaluated once, at compilation;
+/// - consecutive locals on the same hierarchy are fused into a single local.
+///
+/// The parts of Saturation operations built by the rewriting are already rewritten, thus they are
+/// compiled with compile_rewritten(). Other operands were left as is by the rewriting, thus they
+/// are given to compile(), which rewrites them once.
+template <typename C>
+struct compiler
+{
+  /// @brief Needed by mem::variant.
+  using result_type = homomorphism<C>;
+
+  /// @brief The type of a list of homomorphisms.
+  using hom_list_type = std::deque<homomorphism<C>>;
+
+  /// @brief Tell if an homomorphism has a given concrete type.
+  template <typename T>
+  static
+  bool
+  is(const homomorphism<C>& h)
+  noexcept
+  {
+    return h->index() == homomorphism<C>::template index_for_type<T>();
+  }
+
+  /// @brief Get the compiled links of a chain of compositions, the first applied one last.
+  static
+  void
+  flatten(hom_list_type& links, const order<C>& o, const homomorphism<C>& h)
+  {
+    if (is<_composition<C>>(h))
+    {
+      const auto& c = mem::variant_cast<const _composition<C>>(*h);
+      flatten(links, o, c.left());
+      flatten(links, o, c.right());
+    }
+    else
+    {
+      links.push_back(compile(o, h));
+    }
+  }
+
+  /// @brief Evaluate at once all links applied after the last constant of a chain.
+  ///
+  /// A constant returns the same SDD for any non-empty operand, thus what is applied after it
+  /// always computes the same result. Nothing is done if this evaluation can't complete.
+  static
+  void
+  fold_constant(hom_list_type& links, const order<C>& o)
+  {
+    auto rit = links.rbegin();
+    for (; rit != links.rend(); ++rit)
+    {
+      if (is<_constant<C>>(*rit))
+      {
+        break;
+      }
+    }
+    if (rit == links.rend() or std::next(rit) == links.rend())
+    {
+      // No constant, or nothing is applied after it.
+      return;
+    }
+
+    SDD<C> res = mem::variant_cast<const _constant<C>>(**rit).sdd();
+    try
+    {
+      for (auto it = std::next(rit); it != links.rend(); ++it)
+      {
+        res = (*it)(global<C>().hom_context, o, res);
+      }
+    }
+    catch (interrupt<C>&)
+    {
+      return;
+    }
+    catch (evaluation_error<C>&)
+    {
+      return;
+    }
+
+    links.erase(links.begin(), rit.base());
+    links.push_front(constant(res));
+  }
+
+  /// @brief Fuse consecutive locals which target the same hierarchy.
+  static
+  void
+  fuse_locals(hom_list_type& links, const order<C>& o)
+  {
+    hom_list_type fused;
+    for (const auto& h : links)
+    {
+      if (not fused.empty() and is<_local<C>>(fused.back()) and is<_local<C>>(h))
+      {
+        const auto& lhs = mem::variant_cast<const _local<C>>(*fused.back());
+        const auto& rhs = mem::variant_cast<const _local<C>>(*h);
+        if (lhs.target() == rhs.target())
+        {
+          const auto inner = composition(lhs.hom(), rhs.hom());
+          // A composition is left as is by the rewriting, it only needs to be compiled.
+          fused.back() = local( lhs.target()
+                              , lhs.target() == o.position()
+                                ? compile_rewritten(o.nested(), inner)
+                                : inner);
+          continue;
+        }
+      }
+      fused.push_back(h);
+    }
+    links.swap(fused);
+  }
+
+  /// @brief Compile a chain of compositions.
+  homomorphism<C>
+  operator()(const _composition<C>&, const homomorphism<C>& h, const order<C>& o)
+  const
+  {
+    hom_list_type links;
+    flatten(links, o, h);
+    fold_constant(links, o);
+    fuse_locals(links, o);
+
+    // Rebuild the chain, the first applied link being the innermost one.
+    homomorphism<C> res = links.back();
+    for (auto rit = std::next(links.rbegin()); rit != links.rend(); ++rit)
+    {
+      res = composition(*rit, res);
+    }
+    return res;
+  }
+
+  /// @brief Compile the operands of a sum.
+  homomorphism<C>
+  operator()(const _sum<C>& s, const homomorphism<C>&, const order<C>& o)
+  const
+  {
+    hom_list_type operands;
+    for (const auto& op : s)
+    {
+      operands.push_back(compile(o, op));
+    }
+    return sum(o, operands.begin(), operands.end());
+  }
+
+  /// @brief Compile the operands of an intersection.
+  homomorphism<C>
+  operator()(const _intersection<C>& i, const homomorphism<C>&, const order<C>& o)
+  const
+  {
+    hom_list_type operands;
+    for (const auto& op : i)
+    {
+      operands.push_back(compile(o, op));
+    }
+    return intersection(o, operands.begin(), operands.end());
+  }
+
+  /// @brief Compile the operand of a fixpoint.
+  homomorphism<C>
+  operator()(const _fixpoint<C>& f, const homomorphism<C>&, const order<C>& o)
+  const
+  {
+    return fixpoint(compile(o, f.hom()));
+  }
+
+  /// @brief Compile the operand of a local, when it targets the current level.
+  homomorphism<C>
+  operator()(const _local<C>& l, const homomorphism<C>& h, const order<C>& o)
+  const
+  {
+    return l.target() == o.position()
+         ? local(l.target(), compile(o.nested(), l.hom()))
+         : h;
+  }
+
+  /// @brief Compile the L part of a Saturation operation, a local on the current level whose
+  /// operand is already rewritten.
+  static
+  homomorphism<C>
+  compile_L(const homomorphism<C>& h, const order<C>& o)
+  {
+    if (not is<_local<C>>(h))
+    {
+      return compile_rewritten(o, h);
+    }
+    const auto& l = mem::variant_cast<const _local<C>>(*h);
+    return l.target() == o.position()
+         ? local(l.target(), compile_rewritten(o.nested(), l.hom()))
+         : h;
+  }
+
+  /// @brief Compile the parts of a Saturation Sum.
+  homomorphism<C>
+  operator()(const _saturation_sum<C>& s, const homomorphism<C>& h, const order<C>& o)
+  const
+  {
+    if (s.variable() != o.variable())
+    {
+      return h;
+    }
+    hom_list_type G;
+    for (const auto& g : s.G())
+    {
+      G.push_back(compile(o, g));
+    }
+    return saturation_sum( s.variable()
+                         , s.F() ? compile_rewritten(o.next(), *s.F()) : optional_homomorphism<C>()
+                         , G.begin(), G.end()
+                         , s.L() ? compile_L(*s.L(), o) : optional_homomorphism<C>());
+  }
+
+  /// @brief Compile the parts of a Saturation Intersection.
+  homomorphism<C>
+  operator()(const _saturation_intersection<C>& s, const homomorphism<C>& h, const order<C>& o)
+  const
+  {
+    if (s.variable() != o.variable())
+    {
+      return h;
+    }
+    hom_list_type G;
+    for (const auto& g : s.G())
+    {
+      G.push_back(compile(o, g));
+    }
+    return saturation_intersection( s.variable()
+                                  , s.F() ? compile_rewritten(o.next(), *s.F())
+                                          : optional_homomorphism<C>()
+                                  , G.begin(), G.end()
+                                  , s.L() ? compile_L(*s.L(), o) : optional_homomorphism<C>());
+  }
+
+  /// @brief Compile the parts of a Saturation Fixpoint.
+  homomorphism<C>
+  operator()(const _saturation_fixpoint<C>& s, const homomorphism<C>& h, const order<C>& o)
+  const
+  {
+    if (s.variable() != o.variable())
+    {
+      return h;
+    }
+    hom_list_type G;
+    for (auto cit = s.G_begin(); cit != s.G_end(); ++cit)
+    {
+      G.push_back(compile(o, *cit));
+    }
+    return saturation_fixpoint( s.variable(), compile_rewritten(o.next(), s.F())
+                              , G.begin(), G.end(), compile_L(s.L(), o), s.chaining());
+  }
+
+  /// @brief General case.
+  ///
+  /// Any other homomorphism is already a leaf of the evaluation.
+  template <typename T>
+  homomorphism<C>
+  operator()(const T&, const homomorphism<C>& h, const order<C>&)
+  const
+  {
+    return h;
+  }
+};
+
+} // namespace hom
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace hom {
+
+/// @internal
+/// @brief Compile an homomorphism which is already rewritten for a given order.
+template <typename C>
+homomorphism<C>
+compile_rewritten(const order<C>& o, const homomorphism<C>& h)
+{
+  return o.empty()
+       ? h
+       : visit_self(compiler<C>(), h, o);
+}
+
+} // namespace hom
+
+/// @brief Compile an homomorphism for a given order.
+///
+/// The homomorphism is first rewritten to enable saturation, then its chains of compositions are
+/// simplified. The result is equivalent, but faster to evaluate on SDDs built with this order.
+template <typename C>
+homomorphism<C>
+compile(const order<C>& o, const homomorphism<C>& h)
+{
+  return o.empty()
+       ? h
+       : hom::compile_rewritten(o, rewrite(o, h));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
+
+#endif // _SDD_HOM_COMPILE_HH_
@@ -27,6 +27,7 @@ public:
 
   /// @brief Homomorphism evaluation cache type.
   using cache_type = mem::cache< context, cached_homomorphism<C>, evaluation_error<C>
+                               , typename C::cache_eviction
                                , should_cache<C>, one_terminal_evaluation<C>>;
 
   /// @brief SDD operation context type.
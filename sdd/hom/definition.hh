@@ -73,6 +73,17 @@ public:
   /// no longer referenced.
   using ptr_type = mem::ptr<unique_type>;
 
+  /// @internal
+  /// @brief Get the index of a concrete homomorphism type, to be compared with index().
+  template <typename T>
+  static constexpr
+  std::size_t
+  index_for_type()
+  noexcept
+  {
+    return data_type::template index_for_type<T>();
+  }
+
 private:
 
   /// @brief The real smart pointer around a unified homomorphism.
@@ -99,14 +110,6 @@ public:
     return this->operator()(global<C>().hom_context, o, x);
   }
 
-  /// @internal
-  void*
-  env()
-  const noexcept
-  {
-    return nullptr;
-  }
-
   /// @internal
   /// @brief Tell if this homomorphism skips a given identifier.
   ///
@@ -178,11 +181,17 @@ public:
     // hard-wired cases:
     // - if the current homomorphism is Id, then directly return the operand
     // - if the current operand is |0|, then directly return it
+    // - if the current homomorphism is a constant, then directly return its SDD (it's never
+    //   cached, there is no need to go through the cache filters)
     if (*this == id<C>() or x.empty())
     {
       return x;
     }
-    return cxt.cache()(hom::cached_homomorphism<C>(o, *this, x));
+    else if ((*this)->index() == data_type::template index_for_type<hom::_constant<C>>())
+    {
+      return mem::variant_cast<const hom::_constant<C>>(**this).sdd();
+    }
+    return cxt.cache()(hom::cached_homomorphism<C>(*this, x), o);
   }
 
   /// @internal
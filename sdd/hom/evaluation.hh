@@ -115,9 +115,6 @@ struct cached_homomorphism
   /// @brief Needed by the cache.
   using result_type = SDD<C>;
 
-  /// @brief The current order position.
-  const order<C> ord;
-
   /// @brief The homomorphism to evaluate.
   const homomorphism<C> hom;
 
@@ -125,18 +122,19 @@ struct cached_homomorphism
   const SDD<C> sdd;
 
   /// @brief Constructor.
-  cached_homomorphism(const order<C>& o, const homomorphism<C>& h, const SDD<C>& s)
-    : ord(o), hom(h), sdd(s)
+  cached_homomorphism(const homomorphism<C>& h, const SDD<C>& s)
+    : hom(h), sdd(s)
   {}
 
   /// @brief Launch the evaluation.
   ///
-  /// Called by the cache.
+  /// Called by the cache. The current order position is not part of the cached operation, as the
+  /// SDD operand brings the same information: it's given by the caller through the cache.
   SDD<C>
-  operator()(context<C>& cxt)
+  operator()(context<C>& cxt, const order<C>& o)
   const
   {
-    return binary_visit_self(evaluation<C>(), hom, sdd, cxt, ord);
+    return binary_visit_self(evaluation<C>(), hom, sdd, cxt, o);
   }
 };
 
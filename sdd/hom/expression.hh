@@ -17,6 +17,7 @@
 #include "sdd/hom/expression/simple.hh"
 #include "sdd/hom/expression/stacks.hh"
 #include "sdd/hom/identity.hh"
+#include "sdd/hom/touched_positions.hh"
 #include "sdd/order/order.hh"
 
 namespace sdd { namespace hom {
@@ -45,12 +46,16 @@ private:
   /// @brief The target of the assignment.
   const order_position_type target_;
 
+  /// @brief The positions which can't be skipped.
+  const touched_positions touched_;
+
 public:
 
   /// @brief Constructor.
   _expression( std::unique_ptr<expr::evaluator_base<C>>&& e_ptr, order_positions_type&& positions
-             , order_position_type target)
+             , order_position_type target, touched_positions&& touched)
     : eval_ptr_(std::move(e_ptr)), positions_(std::move(positions)), target_(target)
+    , touched_(std::move(touched))
   {}
 
   /// @brief Skip variable predicate.
@@ -58,9 +63,7 @@ public:
   skip(const order<C>& o)
   const noexcept
   {
-    return o.position() != target_ and o.position() != positions_.front()
-       and not o.contains(o.position(), positions_.front())
-       and not o.contains(o.position(), target_);
+    return not touched_.contains(o.position());
   }
 
   /// @brief Selector predicate.
@@ -105,6 +108,14 @@ public:
   {
     return target_;
   }
+
+  /// @brief Get the positions which can't be skipped.
+  const touched_positions&
+  touched()
+  const noexcept
+  {
+    return touched_;
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -118,7 +129,7 @@ operator==(const _expression<C>& lhs, const _expression<C>& rhs)
 noexcept
 {
   return lhs.target() == rhs.target() and lhs.operands() == rhs.operands()
-     and lhs.evaluator() == rhs.evaluator();
+     and lhs.touched() == rhs.touched() and lhs.evaluator() == rhs.evaluator();
 }
 
 /// @internal
@@ -156,12 +167,17 @@ private:
   /// @brief The target of the assignment.
   const order_position_type target_;
 
+  /// @brief The positions which can't be skipped.
+  const touched_positions touched_;
+
 public:
 
   /// @brief Constructor.
   _simple_expression( std::unique_ptr<expr::evaluator_base<C>>&& e_ptr
-                    , order_positions_type&& positions, order_position_type target)
+                    , order_positions_type&& positions, order_position_type target
+                    , touched_positions&& touched)
     : eval_ptr_(std::move(e_ptr)), positions_(std::move(positions)), target_(target)
+    , touched_(std::move(touched))
   {}
 
   /// @brief Skip variable predicate.
@@ -169,9 +185,7 @@ public:
   skip(const order<C>& o)
   const noexcept
   {
-    return o.position() != target_ and o.position() != positions_.front()
-       and not o.contains(o.position(), positions_.front())
-       and not o.contains(o.position(), target_);
+    return not touched_.contains(o.position());
   }
 
   /// @brief Selector predicate.
@@ -216,6 +230,14 @@ public:
   {
     return target_;
   }
+
+  /// @brief Get the positions which can't be skipped.
+  const touched_positions&
+  touched()
+  const noexcept
+  {
+    return touched_;
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -229,7 +251,7 @@ operator==(const _simple_expression<C>& lhs, const _simple_expression<C>& rhs)
 noexcept
 {
   return lhs.target() == rhs.target() and lhs.operands() == rhs.operands()
-     and lhs.evaluator() == rhs.evaluator();
+     and lhs.touched() == rhs.touched() and lhs.evaluator() == rhs.evaluator();
 }
 
 /// @internal
@@ -278,12 +300,16 @@ expression( const order<C>& o, const Evaluator& u, InputIterator begin, InputIte
 
   std::unique_ptr<derived_type> evaluator_ptr(new derived_type(u));
 
+  // The evaluation starts at the first operand or at the target, whichever comes first.
+  hom::touched_positions touched(o, {target_pos, positions.front()});
+
   const auto last_position = positions.back();
   if (target_pos < last_position)
   {
 #if !defined(HAS_NO_BOOST_COROUTINE)
     return homomorphism<C>::create( mem::construct<hom::_expression<C>>()
-                                  , std::move(evaluator_ptr), std::move(positions), target_pos);
+                                  , std::move(evaluator_ptr), std::move(positions), target_pos
+                                  , std::move(touched));
 #else
     throw std::runtime_error("Can't create full expressions without Boost.Coroutine.");
 #endif
@@ -292,7 +318,8 @@ expression( const order<C>& o, const Evaluator& u, InputIterator begin, InputIte
   {
     // The target is below all operands, it's a much simpler case to handle
     return homomorphism<C>::create( mem::construct<hom::_simple_expression<C>>()
-                                  , std::move(evaluator_ptr), std::move(positions), target_pos);
+                                  , std::move(evaluator_ptr), std::move(positions), target_pos
+                                  , std::move(touched));
   }
 }
 
@@ -0,0 +1,91 @@
+#ifndef _SDD_HOM_PARALLEL_SATURATION_HH_
+#define _SDD_HOM_PARALLEL_SATURATION_HH_
+
+#if defined LIBSDD_THREAD_SAFE
+
+#include <algorithm> // any_of
+#include <utility>   // move
+#include <vector>
+
+#include "sdd/internal_manager_fwd.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/hom/common_types.hh"
+#include "sdd/hom/context_fwd.hh"
+#include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/interrupt.hh"
+#include "sdd/order/order.hh"
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Evaluate the operands of a Saturation Sum or Intersection as parallel tasks.
+/// @param op Merges the results, given in a Builder, with a single n-ary operation.
+///
+/// The F, G and L operands are applied to the same SDD, thus they don't depend on each other. If
+/// some of them are interrupted, all the others are still evaluated, then their results are
+/// merged with the partial results and an interrupt is thrown with this merged result.
+template <typename C, typename Builder, typename Operation>
+SDD<C>
+parallel_saturation( context<C>& cxt, const order<C>& o, const SDD<C>& s
+                   , const optional_homomorphism<C>& f, const homomorphism_set<C>& g
+                   , const optional_homomorphism<C>& l, Operation&& op)
+{
+  std::vector<const homomorphism<C>*> operands;
+  operands.reserve(g.size() + 2);
+  if (f)
+  {
+    operands.push_back(&*f);
+  }
+  for (const auto& h : g)
+  {
+    operands.push_back(&h);
+  }
+  if (l)
+  {
+    operands.push_back(&*l);
+  }
+
+  std::vector<SDD<C>> results(operands.size());
+  // Not a std::vector<bool>: tasks write to different elements at the same time.
+  std::vector<char> interrupted(operands.size(), 0);
+
+  // One operand per task: the evaluation of a single homomorphism may be long.
+  global<C>().workers.parallel_for( operands.size(), 1
+                                  , [&](std::size_t i)
+                                      {
+                                        try
+                                        {
+                                          results[i] = (*operands[i])(cxt, o, s);
+                                        }
+                                        catch (interrupt<C>& e)
+                                        {
+                                          results[i] = e.result();
+                                          interrupted[i] = 1;
+                                        }
+                                      });
+
+  Builder builder;
+  builder.reserve(results.size());
+  for (auto& r : results)
+  {
+    builder.add(std::move(r));
+  }
+
+  if (std::any_of(interrupted.cbegin(), interrupted.cend(), [](char x){return x != 0;}))
+  {
+    interrupt<C> i;
+    i.result() = op(std::move(builder));
+    throw i;
+  }
+  return op(std::move(builder));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
+
+#endif // LIBSDD_THREAD_SAFE
+
+#endif // _SDD_HOM_PARALLEL_SATURATION_HH_
@@ -5,6 +5,7 @@
 #include <deque>
 #include <tuple>
 
+#include "sdd/internal_manager_fwd.hh"
 #include "sdd/hom/common_types.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
@@ -225,6 +226,7 @@ struct rewriter
                                     , rewrite( o.nested()
                                              , fixpoint(sum(o.nested(), L.begin(), L.end())))
                                     )
+                             , global<C>().saturation_chaining
                              );
   }
 
@@ -16,6 +16,7 @@
 #include "sdd/hom/identity.hh"
 #include "sdd/hom/interrupt.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/saturation_statistics.hh"
 #include "sdd/order/order.hh"
 #include "sdd/util/packed.hh"
 
@@ -53,16 +54,20 @@ private:
   /// @brief The homomorphism's L part.
   const homomorphism<C> L_;
 
+  /// @brief Tell if each G operand is applied until a local fixpoint before the next one.
+  const bool chaining_;
+
 public:
 
   /// @brief Constructor.
   _saturation_fixpoint( variable_type var, const homomorphism<C>& f
                       , boost::container::flat_set<homomorphism<C>>& g
-                      , const homomorphism<C>& l)
+                      , const homomorphism<C>& l, bool chaining)
     : variable_(var)
     , F_(f)
     , G_size_(static_cast<operands_size_type>(g.size()))
     , L_(l)
+    , chaining_(chaining)
   {
     // Put all homomorphisms operands right after this sum instance.
     hom::consolidate(G_operands_addr(), g.begin(), g.end());
@@ -78,10 +83,17 @@ public:
   }
 
   /// @brief Evaluation.
+  ///
+  /// With chaining, each G operand is applied until it doesn't add anything before the next one
+  /// is applied. Thus, the effects of G operands are propagated in the same round rather than in
+  /// the following ones, which is much faster for models like Petri nets.
   SDD<C>
   operator()(context<C>& cxt, const order<C>& o, const SDD<C>& s)
   const
   {
+    auto& stats = global<C>().saturation_stats;
+    stats.add_evaluation();
+
     SDD<C> s1 = s;
     SDD<C> s2 = s;
 
@@ -90,6 +102,7 @@ public:
       do
       {
         s1 = s2;
+        stats.add_round();
 
         try
         {
@@ -108,7 +121,13 @@ public:
           try
           {
             // chain applications of G
-            s2 = dd::sum(cxt.sdd_context(), {s2, g(cxt, o, s2)});
+            SDD<C> previous;
+            do
+            {
+              previous = s2;
+              stats.add_g_application();
+              s2 = dd::sum(cxt.sdd_context(), {s2, g(cxt, o, s2)});
+            } while (chaining_ and previous != s2);
           }
           catch(interrupt<C>& i)
           {
@@ -155,6 +174,14 @@ public:
     return variable_;
   }
 
+  /// @brief Tell if each G operand is applied until a local fixpoint before the next one.
+  bool
+  chaining()
+  const noexcept
+  {
+    return chaining_;
+  }
+
   /// @brief Get the forwardable part.
   homomorphism<C>
   F()
@@ -222,6 +249,7 @@ operator==(const _saturation_fixpoint<C>& lhs, const _saturation_fixpoint<C>& rh
 noexcept
 {
   return lhs.variable() == rhs.variable()
+     and lhs.chaining() == rhs.chaining()
      and lhs.F() == rhs.F()
      and lhs.L() == rhs.L()
      and lhs.G_size() == rhs.G_size()
@@ -234,7 +262,7 @@ template <typename C>
 std::ostream&
 operator<<(std::ostream& os, const _saturation_fixpoint<C>& s)
 {
-  os << "Sat(@" << s.variable() << ",  " << s.F() << " + " << s.L();
+  os << (s.chaining() ? "ChainSat(@" : "Sat(@") << s.variable() << ",  " << s.F() << " + " << s.L();
   if (not (s.G_size() == 0))
   {
     os << " + ";
@@ -253,12 +281,14 @@ operator<<(std::ostream& os, const _saturation_fixpoint<C>& s)
 ///
 /// We suppose that a saturation fixpoint is created in the rewriting process. Thus, we assume
 /// that operands of the G part are already optimized (e.g. local merged and sums flatten).
+/// With chaining, each G operand is applied until a local fixpoint before the next one.
 template <typename C, typename InputIterator>
 homomorphism<C>
 saturation_fixpoint( typename C::variable_type var
                   , const homomorphism<C>& f
                   , InputIterator gbegin, InputIterator gend
-                  , const homomorphism<C>& l)
+                  , const homomorphism<C>& l
+                  , bool chaining = false)
 {
   const std::size_t gsize = std::distance(gbegin, gend);
 
@@ -274,13 +304,18 @@ saturation_fixpoint( typename C::variable_type var
     }
   }
 
+#if defined LIBSDD_THREAD_SAFE
+  // Homomorphisms may be created by several threads, the global flat_set can't be shared.
+  boost::container::flat_set<homomorphism<C>> g;
+#else
   // A global flat_set to avoid reallocating a new set of operands each time.
   auto& g = global<C>().saturation_fixpoint_data;
   g.clear();
+#endif
   g.insert(gbegin, gend);
   const std::size_t extra_bytes = g.size() * sizeof(homomorphism<C>);
   return homomorphism<C>::create_variable_size( mem::construct<_saturation_fixpoint<C>>()
-                                              , extra_bytes, var, f, g, l);
+                                              , extra_bytes, var, f, g, l, chaining);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -301,6 +336,7 @@ struct hash<sdd::hom::_saturation_fixpoint<C>>
   const
   {
     std::size_t seed = sdd::util::hash(s.variable());
+    sdd::util::hash_combine(seed, s.chaining());
     sdd::util::hash_combine(seed, s.F());
     sdd::util::hash_combine(seed, s.L());
     sdd::util::hash_combine(seed, s.G_begin(), s.G_end());
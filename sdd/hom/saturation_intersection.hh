@@ -5,6 +5,7 @@
 #include <iosfwd>
 #include <stdexcept>  //invalid_argument
 
+#include "sdd/internal_manager_fwd.hh"
 #include "sdd/dd/definition.hh"
 #include "sdd/hom/common_types.hh"
 #include "sdd/hom/context_fwd.hh"
@@ -14,6 +15,7 @@
 #include "sdd/hom/intersection.hh"
 #include "sdd/hom/interrupt.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/parallel_saturation.hh"
 #include "sdd/order/order.hh"
 #include "sdd/util/packed.hh"
 
@@ -58,11 +60,23 @@ public:
   operator()(context<C>& cxt, const order<C>& o, const SDD<C>& s)
   const
   {
-    dd::intersection_builder<C, SDD<C>> operands;
-    operands.reserve(G_.size() + 2);
-
     try
     {
+#if defined LIBSDD_THREAD_SAFE
+      if (global<C>().parallel_saturation)
+      {
+        return parallel_saturation<C, dd::intersection_builder<C, SDD<C>>>
+          ( cxt, o, s, F_, G_, L_
+          , [&](dd::intersection_builder<C, SDD<C>>&& operands)
+              {
+                return dd::intersection(cxt.sdd_context(), std::move(operands));
+              });
+      }
+#endif
+
+      dd::intersection_builder<C, SDD<C>> operands;
+      operands.reserve(G_.size() + 2);
+
       try
       {
         if (F_)
@@ -0,0 +1,108 @@
+#ifndef _SDD_HOM_SATURATION_STATISTICS_HH_
+#define _SDD_HOM_SATURATION_STATISTICS_HH_
+
+#include <cstddef> // size_t
+#if defined LIBSDD_THREAD_SAFE
+#include <atomic>
+#endif
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Count the work done by the evaluations of Saturation Fixpoints.
+///
+/// Used to compare the default saturation with the chaining one: the latter should need fewer
+/// rounds, each of them applying the G operands more often.
+class saturation_statistics
+{
+private:
+
+#if defined LIBSDD_THREAD_SAFE
+  using counter_type = std::atomic<std::size_t>;
+#else
+  using counter_type = std::size_t;
+#endif
+
+  /// @brief The number of evaluations of Saturation Fixpoints.
+  counter_type evaluations_;
+
+  /// @brief The number of rounds of the outer loops, which apply F, L and all G operands.
+  counter_type rounds_;
+
+  /// @brief The number of applications of G operands.
+  counter_type g_applications_;
+
+public:
+
+  /// @brief Default constructor.
+  saturation_statistics()
+    : evaluations_(0)
+    , rounds_(0)
+    , g_applications_(0)
+  {}
+
+  /// @brief The number of evaluations of Saturation Fixpoints.
+  std::size_t
+  evaluations()
+  const noexcept
+  {
+    return evaluations_;
+  }
+
+  /// @brief The number of rounds of the outer loops, for all evaluations.
+  std::size_t
+  rounds()
+  const noexcept
+  {
+    return rounds_;
+  }
+
+  /// @brief The number of applications of G operands, for all evaluations.
+  std::size_t
+  g_applications()
+  const noexcept
+  {
+    return g_applications_;
+  }
+
+  /// @internal
+  void
+  add_evaluation()
+  noexcept
+  {
+    ++evaluations_;
+  }
+
+  /// @internal
+  void
+  add_round()
+  noexcept
+  {
+    ++rounds_;
+  }
+
+  /// @internal
+  void
+  add_g_application()
+  noexcept
+  {
+    ++g_applications_;
+  }
+
+  /// @brief Set all counters to 0.
+  void
+  reset()
+  noexcept
+  {
+    evaluations_ = 0;
+    rounds_ = 0;
+    g_applications_ = 0;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
+
+#endif // _SDD_HOM_SATURATION_STATISTICS_HH_
@@ -0,0 +1,76 @@
+#ifndef _SDD_HOM_TOUCHED_POSITIONS_HH_
+#define _SDD_HOM_TOUCHED_POSITIONS_HH_
+
+#include <algorithm>  // max
+#include <initializer_list>
+#include <vector>
+
+#include "sdd/order/order.hh"
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The positions of an order that an homomorphism can't skip.
+///
+/// Computed once when the homomorphism is created, it turns the skip predicate into a single bit
+/// test, rather than searches in the paths of the order's nodes at each evaluation.
+class touched_positions
+{
+private:
+
+  /// @brief One bit per position, up to the last touched one.
+  std::vector<bool> bits_;
+
+public:
+
+  /// @brief Constructor.
+  ///
+  /// Each given position is touched, as well as all positions of the hierarchies containing it.
+  template <typename C>
+  touched_positions(const order<C>& o, std::initializer_list<order_position_type> positions)
+    : bits_()
+  {
+    order_position_type max = 0;
+    for (const auto pos : positions)
+    {
+      max = std::max(max, pos);
+      for (const auto upper : o.nodes()[pos].path())
+      {
+        max = std::max(max, upper);
+      }
+    }
+    bits_.resize(max + 1, false);
+    for (const auto pos : positions)
+    {
+      bits_[pos] = true;
+      for (const auto upper : o.nodes()[pos].path())
+      {
+        bits_[upper] = true;
+      }
+    }
+  }
+
+  /// @brief Tell if a position is touched.
+  bool
+  contains(order_position_type pos)
+  const noexcept
+  {
+    return pos < bits_.size() and bits_[pos];
+  }
+
+  /// @brief Equality.
+  bool
+  operator==(const touched_positions& other)
+  const noexcept
+  {
+    return bits_ == other.bits_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
+
+#endif // _SDD_HOM_TOUCHED_POSITIONS_HH_
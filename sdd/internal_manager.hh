@@ -2,6 +2,7 @@
 #define _SDD_INTERNAL_MANAGER_HH_
 
 #include <cassert>
+#include <type_traits> // conditional
 
 #include <boost/container/flat_set.hpp>
 
@@ -11,8 +12,15 @@
 #include "sdd/hom/context.hh"
 #include "sdd/hom/definition.hh"
 #include "sdd/hom/identity.hh"
+#include "sdd/hom/saturation_statistics.hh"
 #include "sdd/mem/cache.hh"
+#include "sdd/mem/concurrent_unique_table.hh"
+#include "sdd/mem/hash_table.hh"
+#include "sdd/mem/open_hash_table.hh"
 #include "sdd/mem/unique_table.hh"
+#if defined LIBSDD_THREAD_SAFE
+#include "sdd/util/work_stealing_pool.hh"
+#endif
 
 namespace sdd {
 
@@ -46,16 +54,42 @@ struct internal_manager
   /// @brief The type of a smart pointer to a unified homomorphism.
   using hom_ptr_type = typename homomorphism<C>::ptr_type;
 
+  /// @brief The type of a unique table, with the container chosen by the configuration.
+  ///
+  /// Unique tables are shared by all threads when the library is thread-safe.
+  template <typename Unique>
+#if defined LIBSDD_THREAD_SAFE
+  using unique_table_type
+    = mem::concurrent_unique_table< Unique
+                                  , typename std::conditional< C::open_addressing_unique_tables
+                                                             , mem::open_hash_table<Unique>
+                                                             , mem::hash_table<Unique>>::type>;
+#else
+  using unique_table_type
+    = mem::unique_table< Unique
+                       , typename std::conditional< C::open_addressing_unique_tables
+                                                  , mem::open_hash_table<Unique>
+                                                  , mem::hash_table<Unique>>::type>;
+#endif
+
   /// @brief Manage the handlers needed by ptr when a unified data is no longer referenced.
   struct ptr_handlers
   {
-    ptr_handlers( mem::unique_table<proto_env_unique_type>& proto_env_ut
-                , mem::unique_table<sdd_unique_type>& sdd_ut
-                , mem::unique_table<hom_unique_type>& hom_ut)
+    ptr_handlers( unique_table_type<proto_env_unique_type>& proto_env_ut
+                , unique_table_type<sdd_unique_type>& sdd_ut
+                , unique_table_type<hom_unique_type>& hom_ut
+                , dd::combinations_cache& combinations)
     {
       mem::set_deletion_handler<proto_env_unique_type>([&](const proto_env_unique_type& u)
                                                           {proto_env_ut.erase(u);});
-      mem::set_deletion_handler<sdd_unique_type>([&](const sdd_unique_type& u){sdd_ut.erase(u);});
+      mem::set_deletion_handler<sdd_unique_type>([&](const sdd_unique_type& u)
+      {
+        if (combinations.enabled() and u.data().index() == SDD<C>::proto_node_index)
+        {
+          combinations.erase(u.id());
+        }
+        sdd_ut.erase(u);
+      });
       mem::set_deletion_handler<hom_unique_type>([&](const hom_unique_type& u){hom_ut.erase(u);});
     }
 
@@ -67,17 +101,22 @@ struct internal_manager
     }
   } handlers;
 
+  /// @brief The number of combinations of nodes, kept across calls to SDD::size().
+  ///
+  /// Declared before the unique tables: it's updated when they erase an SDD.
+  dd::combinations_cache combinations_cache;
+
   /// @brief The set of unified proto environments.
-  mem::unique_table<proto_env_unique_type> proto_env_unique_table;
+  unique_table_type<proto_env_unique_type> proto_env_unique_table;
 
   /// @brief The set of unified SDD.
-  mem::unique_table<sdd_unique_type> sdd_unique_table;
+  unique_table_type<sdd_unique_type> sdd_unique_table;
 
   /// @brief The SDD operations evaluation context.
   dd::context<C> sdd_context;
 
   /// @brief The set of unified homomorphisms.
-  mem::unique_table<hom_unique_type> hom_unique_table;
+  unique_table_type<hom_unique_type> hom_unique_table;
 
   /// @brief The homomorphisms evaluation context.
   hom::context<C> hom_context;
@@ -97,30 +136,99 @@ struct internal_manager
   /// @brief Used to avoid frequent useless reallocations in saturation_fixpoint().
   boost::container::flat_set<homomorphism<C>> saturation_fixpoint_data;
 
+  /// @brief Tell if Saturation Fixpoints apply each G operand until a local fixpoint.
+  const bool saturation_chaining;
+
+  /// @brief Count the work done by Saturation Fixpoints.
+  hom::saturation_statistics saturation_stats;
+
   /// @brief Used by proto_arcs_cache.
   dummy_context dummy_cxt;
 
   /// @brief Cache the construction of arcs from a proto_node.
-  mem::cache<dummy_context, mk_arcs_op<C, sdd_ptr_type<C>>, dummy_error> proto_arcs_cache;
+  mem::cache< dummy_context, mk_arcs_op<C, sdd_ptr_type<C>>, dummy_error
+            , typename C::cache_eviction> proto_arcs_cache;
+
+#if defined LIBSDD_THREAD_SAFE
+  /// @brief The minimal number of values whose successors are summed by a single parallel task.
+  const std::size_t sum_grain_size;
+
+  /// @brief Tell if the operands of Saturation Sums and Intersections are evaluated in parallel.
+  const bool parallel_saturation;
+
+  /// @brief The threads which evaluate operations in parallel.
+  ///
+  /// It's the last member: workers are stopped before anything else is destroyed.
+  util::work_stealing_pool workers;
+#endif
 
   /// @brief Constructor with a given configuration.
   internal_manager(const C& configuration)
-    : handlers(proto_env_unique_table, sdd_unique_table, hom_unique_table)
-    , proto_env_unique_table(configuration.sdd_unique_table_size)
-    , sdd_unique_table(configuration.sdd_unique_table_size)
+    : handlers(proto_env_unique_table, sdd_unique_table, hom_unique_table, combinations_cache)
+    , combinations_cache(configuration.combinations_cache)
+    , proto_env_unique_table( configuration.sdd_unique_table_size
+                            , configuration.unique_tables_huge_pages
+                            , configuration.gc_threshold)
+    , sdd_unique_table( configuration.sdd_unique_table_size
+                      , configuration.unique_tables_huge_pages
+                      , configuration.gc_threshold)
     , sdd_context( configuration.sdd_difference_cache_size
                  , configuration.sdd_intersection_cache_size
                  , configuration.sdd_sum_cache_size)
-    , hom_unique_table(configuration.hom_unique_table_size)
+    , hom_unique_table( configuration.hom_unique_table_size
+                      , configuration.unique_tables_huge_pages
+                      , configuration.gc_threshold)
     , hom_context(configuration.hom_cache_size, sdd_context)
     , empty_proto_env(mk_empty_proto_env())
     , zero(mk_terminal<zero_terminal<C>>())
     , one(mk_terminal<one_terminal<C>>())
     , id(mk_id())
     , saturation_fixpoint_data()
+    , saturation_chaining(configuration.saturation_chaining)
+    , saturation_stats()
     , dummy_cxt()
-    , proto_arcs_cache(dummy_cxt, "mk_arcs_cache", 10000)
-  {}
+    , proto_arcs_cache(dummy_cxt, "mk_arcs_cache", configuration.proto_arcs_cache_size)
+#if defined LIBSDD_THREAD_SAFE
+    , sum_grain_size(configuration.sum_grain_size)
+    , parallel_saturation(configuration.parallel_saturation)
+    , workers(configuration.nb_worker_threads)
+#endif
+  {
+    if (configuration.proto_arcs_cache_adaptive)
+    {
+      proto_arcs_cache.adaptive( configuration.proto_arcs_cache_max_miss_rate
+                               , configuration.proto_arcs_cache_max_size);
+    }
+  }
+
+  /// @brief Destructor.
+  ///
+  /// Unique tables are destroyed one after the other, thus data must be erased as soon as it's no
+  /// longer referenced from now on.
+  ~internal_manager()
+  {
+    gc();
+    hom_unique_table.eager();
+    sdd_unique_table.eager();
+    proto_env_unique_table.eager();
+  }
+
+  /// @brief Clear all caches and erase all unreferenced SDD, proto environments and
+  /// homomorphisms.
+  ///
+  /// Must not be called while operations are evaluated.
+  void
+  gc()
+  {
+    sdd_context.clear();
+    hom_context.clear();
+    proto_arcs_cache.clear();
+    saturation_fixpoint_data.clear();
+    // Proto environments reference SDD, thus they may release data of the other tables.
+    while ( hom_unique_table.collect() + sdd_unique_table.collect()
+          + proto_env_unique_table.collect() != 0)
+    {}
+  }
 
 private:
 
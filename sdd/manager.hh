@@ -112,6 +112,16 @@ public:
     m_->hom_context.clear();
   }
 
+  /// @brief Clear all caches and erase all SDD and homomorphisms which are no longer referenced.
+  ///
+  /// Useful when the configuration sets gc_threshold. Must not be called while operations are
+  /// evaluated by other threads.
+  void
+  gc()
+  {
+    m_->gc();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDDs.
   const mem::unique_table_statistics&
@@ -148,6 +158,15 @@ public:
     return m_->sdd_context.sum_cache().statistics();
   }
 
+  /// @internal
+  /// @brief Get the statistics for the arcs decoded from flat SDD.
+  const mem::cache_statistics&
+  proto_arcs_cache_stats()
+  const noexcept
+  {
+    return m_->proto_arcs_cache.statistics();
+  }
+
   /// @internal
   /// @brief Get the statistics for homomorphisms.
   const mem::unique_table_statistics&
@@ -165,6 +184,14 @@ public:
   {
     return m_->hom_context.cache().statistics();
   }
+
+  /// @brief Get the statistics of Saturation Fixpoints evaluations.
+  hom::saturation_statistics&
+  saturation_stats()
+  noexcept
+  {
+    return m_->saturation_stats;
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -1,18 +1,21 @@
 #ifndef _SDD_MEM_CACHE_HH_
 #define _SDD_MEM_CACHE_HH_
 
-#include <algorithm> // for_each, nth_element
-#include <cstdint>   // uint32_t
+#include <algorithm> // max, min
+#include <cmath>     // ceil
 #include <forward_list>
 #include <iterator>  // distance
+#include <mutex>     // unique_lock
 #include <numeric>   // accumulate
 #include <tuple>
 #include <utility>   // forward
-#include <vector>
 
+#include "sdd/mem/cache_eviction.hh"
 #include "sdd/mem/hash_table.hh"
 #include "sdd/mem/interrupt.hh"
+#include "sdd/util/concurrency.hh"
 #include "sdd/util/hash.hh"
+#include "sdd/util/next_power.hh"
 #include "sdd/util/packed.hh"
 
 namespace sdd { namespace mem {
@@ -64,12 +67,12 @@ namespace /* anonymous */ {
 /// @internal
 /// @brief The statistics of a cache.
 ///
-/// A statistic is made of several rounds: each time a cache is cleaned up, a new round is
-/// created. Thus, one can have detailed statistics to see how well the cache performed.
+/// A statistic is made of several rounds: each time about half of a cache has been evicted, a new
+/// round is created. Thus, one can have detailed statistics to see how well the cache performed.
 struct cache_statistics
 {
   /// @internal
-  /// @brief Statistic between two cleanups.
+  /// @brief Statistic between two cleanups, i.e. two evictions of half of the cache.
   struct round
   {
     round()
@@ -91,9 +94,13 @@ struct cache_statistics
   /// @brief The list of all rounds.
   std::forward_list<round> rounds;
 
+  /// @brief The number of times the cache has been resized.
+  std::size_t resizes;
+
   /// @brief Default constructor.
   cache_statistics()
     : rounds(1)
+    , resizes(0)
   {}
 
   /// @brief Get the number of rounds.
@@ -137,11 +144,15 @@ struct cache_statistics
 /// @brief  A generic cache.
 /// @tparam Operation is the operation type.
 /// @tparam EvaluationError is the exception that the evaluation of an Operation can throw.
+/// @tparam Eviction is the policy which removes old entries (lfu_eviction, clock_eviction or
+/// slru_eviction).
 /// @tparam Filters is a list of filters that reject some operations.
 ///
-/// It uses the LFU strategy to cleanup old entries.
+/// When the library is thread-safe, it can be shared by several threads: the lock is not held
+/// while an operation is evaluated, thus two threads may compute the same operation, in which case
+/// only the first result is kept.
 template < typename Context, typename Operation, typename EvaluationError
-         , typename... Filters>
+         , typename Eviction = lfu_eviction, typename... Filters>
 class cache
 {
   // Can't copy a cache.
@@ -178,13 +189,8 @@ private:
     /// @brief The result of the evaluation of operation.
     const result_type result;
 
-    /// @brief Count the number of times this entry has been accessed.
-    ///
-    /// Used by the LFU cache cleanup strategy.
-    std::uint32_t nb_hits_;
-
-    /// brief The 'in use' bit position in nb_hits_.
-    static constexpr std::uint32_t in_use_mask = (1u << 31);
+    /// @brief Data needed by the eviction policy.
+    typename Eviction::hook eviction_hook;
 
     /// @brief Constructor.
     template <typename... Args>
@@ -192,7 +198,7 @@ private:
       : hook()
       , operation(std::move(op))
       , result(std::forward<Args>(args)...)
-      , nb_hits_(in_use_mask) // initially in use
+      , eviction_hook()
     {}
 
     /// @brief Cache entries are only compared using their operations.
@@ -202,46 +208,6 @@ private:
     {
       return operation == other.operation;
     }
-
-    /// @brief Get the number of hits, with the 'in use' bit possibly set.
-    unsigned int
-    raw_nb_hits()
-    const noexcept
-    {
-      return nb_hits_;
-    }
-
-    /// @brief Set this cache entry to a 'never used' state.
-    void
-    reset_nb_hits()
-    noexcept
-    {
-      nb_hits_ &= in_use_mask;
-    }
-
-    /// @brief Increment the number of hits.
-    void
-    increment_nb_hits()
-    noexcept
-    {
-      ++nb_hits_;
-    }
-
-    /// @brief Set this cache entry to a 'not in use' state.
-    void
-    reset_in_use()
-    noexcept
-    {
-      nb_hits_ &= ~in_use_mask;
-    }
-
-    /// @brief Tell if this cache entry is in an 'in use' state.
-    bool
-    in_use()
-    const noexcept
-    {
-      return nb_hits_ & in_use_mask;
-    }
   };
 
   /// @brief Hash a cache_entry.
@@ -276,9 +242,24 @@ private:
   /// @brief The maximum size this cache is authorized to grow to.
   std::size_t max_size_;
 
+  /// @brief The policy which chooses the entries to remove.
+  typename Eviction::template evictor<cache_entry> evictor_;
+
+  /// @brief The miss rate above which an adaptive cache grows.
+  double max_miss_rate_;
+
+  /// @brief The size an adaptive cache can grow to, 0 if it's not adaptive.
+  std::size_t max_adaptive_size_;
+
+  /// @brief The number of consecutive rounds whose miss rate was above max_miss_rate_.
+  std::size_t missing_rounds_;
+
   /// @brief The statistics of this cache.
   cache_statistics stats_;
 
+  /// @brief Protect the storage and the statistics of this cache.
+  util::mutex mutex_;
+
 public:
 
   /// @brief Construct a cache.
@@ -286,16 +267,21 @@ public:
   /// @param name Give a name to this cache.
   /// @param size tells how many cache entries are keeped in the cache.
   ///
-  /// When the maximal size is reached, a cleanup is launched: half of the cache is removed,
-  /// using an LFU strategy. This cache will never perform a rehash, therefore it allocates
-  /// all the memory it needs at its construction.
+  /// When the wanted load factor is reached, the eviction policy removes entries to make room
+  /// for new ones. This cache performs a rehash only when it's resized, therefore it allocates
+  /// all the memory it needs at its construction otherwise.
   cache(context_type& context, const std::string& name, std::size_t size)
     : cxt_(context)
     , name_(name)
     , max_load_factor_(0.9)
     , set_(size)
     , max_size_(set_.bucket_count())
+    , evictor_(capacity_of(max_size_))
+    , max_miss_rate_(1)
+    , max_adaptive_size_(0)
+    , missing_rounds_(0)
     , stats_()
+    , mutex_()
   {}
 
   /// @brief Destructor.
@@ -305,20 +291,28 @@ public:
   }
 
   /// @brief Cache lookup.
+  /// @param op The operation to look up, evaluated if it's not cached.
+  /// @param args Given to the evaluation of op, they are not part of the cached operation.
+  template <typename... Args>
   result_type
-  operator()(Operation&& op)
+  operator()(Operation&& op, const Args&... args)
   {
+    std::unique_lock<util::mutex> lock(mutex_);
+
     // Check if the current operation should not be cached.
     if (not apply_filters<Operation, Filters...>()(op))
     {
       ++stats_.rounds.front().filtered;
+      lock.unlock();
       try
       {
-        return op(cxt_);
+        return op(cxt_, args...);
       }
       catch (EvaluationError& e)
       {
+        lock.lock();
         --stats_.rounds.front().filtered;
+        lock.unlock();
         e.add_step(std::move(op));
         throw;
       }
@@ -336,95 +330,105 @@ public:
     if (not insertion.second)
     {
       ++stats_.rounds.front().hits;
-      insertion.first->increment_nb_hits();
+      evictor_.hit(*insertion.first);
       return insertion.first->result;
     }
 
     ++stats_.rounds.front().misses;
 
-    // Clean up the cache, if necessary.
-    cleanup();
-
+    // Don't hold the lock while evaluating op, as it may recursively use this cache.
+    lock.unlock();
     cache_entry* entry;
     try
     {
-      entry = new cache_entry(std::move(op), op(cxt_));
+      entry = new cache_entry(std::move(op), op(cxt_, args...));
     }
     catch (EvaluationError& e)
     {
+      lock.lock();
       --stats_.rounds.front().misses;
+      lock.unlock();
       e.add_step(std::move(op));
       throw;
     }
     catch (interrupt<result_type>&)
     {
+      lock.lock();
       --stats_.rounds.front().misses;
+      lock.unlock();
       throw;
     }
-    // A cache entry is constructed with the 'in use' bit set.
-    entry->reset_in_use();
+    lock.lock();
+
+#if defined LIBSDD_THREAD_SAFE
+    // Another thread may have inserted the same operation in the meantime.
+    insertion = set_.insert_check( entry->operation
+                                 , std::hash<Operation>()
+                                 , [](const Operation& lhs, const cache_entry& rhs)
+                                     {return lhs == rhs.operation;}
+                                 , commit_data);
+    if (not insertion.second)
+    {
+      const result_type result = insertion.first->result;
+      lock.unlock();
+      delete entry;
+      return result;
+    }
+#endif
+
+    // Make room for the new entry, if necessary.
+    bool grow = false;
+    if (evictor_.insert(*entry, set_, [&](cache_entry* e){erase(e);}))
+    {
+      grow = end_round();
+    }
     set_.insert_commit(*entry, commit_data); // doesn't throw
+    if (grow)
+    {
+      resize_impl(std::min(2 * max_size_, max_adaptive_size_));
+    }
     return entry->result;
   }
 
-  /// @brief The load factor of the underlying hash table.
-  double
-  load_factor()
-  const noexcept
+  /// @brief Let this cache grow when it misses too often.
+  /// @param max_miss_rate The ratio of misses over lookups above which the cache grows.
+  /// @param max_size The size this cache can't grow beyond.
+  ///
+  /// The size is doubled when the miss rate stays above max_miss_rate during
+  /// adaptive_rounds consecutive rounds.
+  void
+  adaptive(double max_miss_rate, std::size_t max_size)
   {
-    return static_cast<double>(set_.size()) / static_cast<double>(max_size_);
+    std::lock_guard<util::mutex> lock(mutex_);
+    max_miss_rate_ = max_miss_rate;
+    max_adaptive_size_ = max_size;
+    missing_rounds_ = 0;
   }
 
-  /// @brief Remove half of the cache (LFU strategy).
+  /// @brief Change the number of entries this cache can hold.
+  ///
+  /// Entries are kept when the cache grows, they are all removed when it shrinks.
   void
-  cleanup()
+  resize(std::size_t size)
   {
-    if (load_factor() < max_load_factor_)
-    {
-      return;
-    }
-
-    stats_.rounds.emplace_front(cache_statistics::round());
+    std::lock_guard<util::mutex> lock(mutex_);
+    resize_impl(size);
+  }
 
-    std::vector<cache_entry*> vec;
-    vec.reserve(set_.size());
-    for (auto& e : set_)
-    {
-      vec.push_back(&e);
-    }
+  /// @brief Get the number of entries this cache is authorized to grow to.
+  std::size_t
+  capacity()
+  const noexcept
+  {
+    return max_size_;
+  }
 
-    // Compute the number of elements to keep in order to reduce the load factor by a factor of 2.
-    const std::size_t to_keep = static_cast<std::size_t>(max_size_ * max_load_factor_/2);
-    const std::size_t cut_point = vec.size() - to_keep;
-
-    // Find the median of the number of hits.
-    std::nth_element( vec.begin(), vec.begin() + cut_point, vec.end()
-                    , [](cache_entry* lhs, cache_entry* rhs)
-                        {
-                          // We sort using the raw nb_hits counter, with the 'in use' bit possibly
-                          // set. As this is the highest bit, the value of nb_hits may be large.
-                          // Thus, it's very unlikely that cache entries currently in use will be
-                          // put below the median.
-                          return lhs->raw_nb_hits() < rhs->raw_nb_hits();
-                        });
-
-    // Delete all cache entries with a number of entries smaller than the median.
-    std::for_each( vec.begin(), vec.begin() + cut_point
-                 , [&](cache_entry* e)
-                      {
-                        if (not e->in_use())
-                        {
-                          const auto cit = set_.find(*e);
-                          if (cit != set_.end())
-                          {
-                            set_.erase(cit);
-                            delete e;
-                          }
-                        }
-                      });
-
-    // Reset the number of hits of all remaining cache entries.
-    std::for_each(vec.begin() + cut_point, vec.end(), [](cache_entry* e){e->reset_nb_hits();});
+  /// @brief The load factor of the underlying hash table.
+  double
+  load_factor()
+  const noexcept
+  {
+    return static_cast<double>(set_.size()) / static_cast<double>(max_size_);
   }
 
   /// @brief Remove all entries of the cache.
@@ -432,7 +436,9 @@ public:
   clear()
   noexcept
   {
+    std::lock_guard<util::mutex> lock(mutex_);
     set_.clear_and_dispose([](cache_entry* x){delete x;});
+    evictor_.clear();
   }
 
   /// @brief Get the number of cached operations.
@@ -458,6 +464,69 @@ public:
   {
     return name_;
   }
+
+  /// @brief The number of consecutive rounds with a high miss rate which makes an adaptive cache
+  /// grow.
+  static constexpr std::size_t adaptive_rounds = 2;
+
+private:
+
+  /// @brief Get the number of entries which triggers the eviction policy.
+  std::size_t
+  capacity_of(std::size_t size)
+  const noexcept
+  {
+    return static_cast<std::size_t>(std::ceil(size * max_load_factor_));
+  }
+
+  /// @brief Start a new round of statistics.
+  /// @return true if an adaptive cache should grow.
+  bool
+  end_round()
+  {
+    const auto& round = stats_.rounds.front();
+    const std::size_t lookups = round.hits + round.misses;
+    if ( lookups != 0
+        and static_cast<double>(round.misses) > max_miss_rate_ * static_cast<double>(lookups))
+    {
+      ++missing_rounds_;
+    }
+    else
+    {
+      missing_rounds_ = 0;
+    }
+    stats_.rounds.emplace_front(cache_statistics::round());
+    if (missing_rounds_ >= adaptive_rounds and max_size_ < max_adaptive_size_)
+    {
+      missing_rounds_ = 0;
+      return true;
+    }
+    return false;
+  }
+
+  /// @brief Change the number of entries this cache can hold, the lock being held.
+  void
+  resize_impl(std::size_t size)
+  {
+    const std::size_t nb_buckets = std::max<std::size_t>(size, 1);
+    if (capacity_of(util::next_power_of_2(static_cast<std::uint32_t>(nb_buckets))) < set_.size())
+    {
+      set_.clear_and_dispose([](cache_entry* x){delete x;});
+      evictor_.clear();
+    }
+    set_.rehash(nb_buckets);
+    max_size_ = set_.bucket_count();
+    evictor_.resize(capacity_of(max_size_));
+    ++stats_.resizes;
+  }
+
+  /// @brief Remove an entry chosen by the eviction policy.
+  void
+  erase(cache_entry* e)
+  {
+    set_.erase(set_.find(*e));
+    delete e;
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
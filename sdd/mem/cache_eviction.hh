@@ -0,0 +1,437 @@
+#ifndef _SDD_MEM_CACHE_EVICTION_HH_
+#define _SDD_MEM_CACHE_EVICTION_HH_
+
+#include <algorithm> // for_each, nth_element
+#include <cstdint>   // uint32_t
+#include <vector>
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+// An eviction policy of a cache provides:
+//  - a hook type, stored in each cache entry under the name eviction_hook;
+//  - an evictor class template, instantiated with the type of cache entries, which has:
+//    - evictor(std::size_t capacity)
+//    - void hit(Entry&): an entry has been found in the cache;
+//    - bool insert(Entry&, Set&, Erase): make room for an entry which is about to be inserted
+//      in Set, by calling Erase on the evicted entries, then register it. Return true when a new
+//      round of statistics should be started;
+//    - void clear(): all entries have been removed from the cache;
+//    - void resize(std::size_t capacity): change the capacity, either to grow while keeping all
+//      entries, or to shrink right after a clear().
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Remove the least frequently used half of the cache when it's full.
+///
+/// All entries are visited at each cleanup. Each cleanup starts a new round of statistics.
+struct lfu_eviction
+{
+  /// @brief Stored in each cache entry.
+  struct hook
+  {
+    /// @brief Count the number of times this entry has been accessed.
+    std::uint32_t nb_hits;
+
+    hook()
+    noexcept
+      : nb_hits(0)
+    {}
+  };
+
+  /// @brief The actual eviction implementation.
+  template <typename Entry>
+  class evictor
+  {
+  private:
+
+    /// @brief The number of entries which triggers a cleanup.
+    std::size_t capacity_;
+
+  public:
+
+    /// @brief Constructor.
+    evictor(std::size_t capacity)
+      : capacity_(capacity)
+    {}
+
+    /// @brief An entry has been found in the cache.
+    void
+    hit(Entry& e)
+    noexcept
+    {
+      ++e.eviction_hook.nb_hits;
+    }
+
+    /// @brief Change the number of entries which triggers a cleanup.
+    void
+    resize(std::size_t capacity)
+    noexcept
+    {
+      capacity_ = capacity;
+    }
+
+    /// @brief Remove half of the cache if it's full.
+    template <typename Set, typename Erase>
+    bool
+    insert(Entry&, Set& set, Erase&& erase)
+    {
+      if (set.size() < capacity_)
+      {
+        return false;
+      }
+
+      std::vector<Entry*> vec;
+      vec.reserve(set.size());
+      for (auto& e : set)
+      {
+        vec.push_back(&e);
+      }
+
+      // Compute the number of elements to keep in order to reduce the load by a factor of 2.
+      const std::size_t cut_point = vec.size() - capacity_ / 2;
+
+      // Find the median of the number of hits.
+      std::nth_element( vec.begin(), vec.begin() + cut_point, vec.end()
+                      , [](Entry* lhs, Entry* rhs)
+                          {
+                            return lhs->eviction_hook.nb_hits < rhs->eviction_hook.nb_hits;
+                          });
+
+      // Delete all cache entries with a number of entries smaller than the median.
+      std::for_each(vec.begin(), vec.begin() + cut_point, erase);
+
+      // Reset the number of hits of all remaining cache entries.
+      std::for_each( vec.begin() + cut_point, vec.end()
+                   , [](Entry* e){e->eviction_hook.nb_hits = 0;});
+
+      return true;
+    }
+
+    /// @brief All entries have been removed.
+    void
+    clear()
+    noexcept
+    {}
+  };
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Evict one entry per insertion using the CLOCK algorithm.
+///
+/// Entries are stored in a circular buffer of the size of the cache. When the cache is full, the
+/// hand sweeps entries, giving a second chance to the ones which have been accessed since its
+/// previous sweep, until it finds an entry to replace. A new round of statistics starts each time
+/// half of the cache has been evicted.
+struct clock_eviction
+{
+  /// @brief Stored in each cache entry.
+  struct hook
+  {
+    /// @brief Tell if this entry has been accessed since the hand last passed over it.
+    bool referenced;
+
+    hook()
+    noexcept
+      : referenced(false)
+    {}
+  };
+
+  /// @brief The actual eviction implementation.
+  template <typename Entry>
+  class evictor
+  {
+  private:
+
+    /// @brief The maximal number of entries.
+    std::size_t capacity_;
+
+    /// @brief The circular buffer of entries.
+    std::vector<Entry*> entries_;
+
+    /// @brief The position of the next entry to examine.
+    std::size_t hand_;
+
+    /// @brief The number of evictions since the beginning of the current round.
+    std::size_t evictions_;
+
+  public:
+
+    /// @brief Constructor.
+    evictor(std::size_t capacity)
+      : capacity_(capacity)
+      , entries_()
+      , hand_(0)
+      , evictions_(0)
+    {
+      entries_.reserve(capacity_);
+    }
+
+    /// @brief An entry has been found in the cache.
+    void
+    hit(Entry& e)
+    noexcept
+    {
+      e.eviction_hook.referenced = true;
+    }
+
+    /// @brief Change the maximal number of entries.
+    ///
+    /// When growing, new entries are appended to the buffer until it's full again.
+    void
+    resize(std::size_t capacity)
+    {
+      capacity_ = capacity;
+      entries_.reserve(capacity_);
+    }
+
+    /// @brief Replace the first entry not referenced since the last sweep, if the cache is full.
+    template <typename Set, typename Erase>
+    bool
+    insert(Entry& e, Set&, Erase&& erase)
+    {
+      if (entries_.size() < capacity_)
+      {
+        entries_.push_back(&e);
+        return false;
+      }
+
+      while (entries_[hand_]->eviction_hook.referenced)
+      {
+        entries_[hand_]->eviction_hook.referenced = false;
+        hand_ = hand_ + 1 == capacity_ ? 0 : hand_ + 1;
+      }
+      erase(entries_[hand_]);
+      entries_[hand_] = &e;
+      hand_ = hand_ + 1 == capacity_ ? 0 : hand_ + 1;
+
+      if (++evictions_ < capacity_ / 2)
+      {
+        return false;
+      }
+      evictions_ = 0;
+      return true;
+    }
+
+    /// @brief All entries have been removed.
+    void
+    clear()
+    noexcept
+    {
+      entries_.clear();
+      hand_ = 0;
+      evictions_ = 0;
+    }
+  };
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Evict one entry per insertion using a segmented LRU.
+///
+/// New entries are put in a probationary segment. An entry which is accessed again is promoted
+/// to a protected segment, which occupies at most 80% of the cache and whose least recently used
+/// entries are demoted back to the probationary segment. When the cache is full, the least
+/// recently used entry of the probationary segment is evicted. A new round of statistics starts
+/// each time half of the cache has been evicted.
+struct slru_eviction
+{
+  /// @brief Stored in each cache entry.
+  struct hook
+  {
+    /// @brief The previous (more recently used) entry in the same segment.
+    void* prev;
+
+    /// @brief The next (less recently used) entry in the same segment.
+    void* next;
+
+    /// @brief Tell in which segment this entry is.
+    bool is_protected;
+
+    hook()
+    noexcept
+      : prev(nullptr)
+      , next(nullptr)
+      , is_protected(false)
+    {}
+  };
+
+  /// @brief The actual eviction implementation.
+  template <typename Entry>
+  class evictor
+  {
+  private:
+
+    /// @brief An intrusive doubly-linked list of entries, from the most recently used.
+    struct segment
+    {
+      Entry* head;
+      Entry* tail;
+      std::size_t size;
+
+      segment()
+        : head(nullptr), tail(nullptr), size(0)
+      {}
+
+      static
+      Entry*
+      prev(Entry* e)
+      noexcept
+      {
+        return static_cast<Entry*>(e->eviction_hook.prev);
+      }
+
+      static
+      Entry*
+      next(Entry* e)
+      noexcept
+      {
+        return static_cast<Entry*>(e->eviction_hook.next);
+      }
+
+      void
+      push_front(Entry* e)
+      noexcept
+      {
+        e->eviction_hook.prev = nullptr;
+        e->eviction_hook.next = head;
+        if (head != nullptr)
+        {
+          head->eviction_hook.prev = e;
+        }
+        else
+        {
+          tail = e;
+        }
+        head = e;
+        ++size;
+      }
+
+      void
+      unlink(Entry* e)
+      noexcept
+      {
+        if (prev(e) != nullptr)
+        {
+          prev(e)->eviction_hook.next = e->eviction_hook.next;
+        }
+        else
+        {
+          head = next(e);
+        }
+        if (next(e) != nullptr)
+        {
+          next(e)->eviction_hook.prev = e->eviction_hook.prev;
+        }
+        else
+        {
+          tail = prev(e);
+        }
+        --size;
+      }
+    };
+
+    /// @brief The maximal number of entries.
+    std::size_t capacity_;
+
+    /// @brief The maximal number of entries in the protected segment.
+    std::size_t protected_capacity_;
+
+    /// @brief Entries accessed only once since their insertion or their demotion.
+    segment probation_;
+
+    /// @brief Entries accessed several times.
+    segment protected_;
+
+    /// @brief The number of evictions since the beginning of the current round.
+    std::size_t evictions_;
+
+  public:
+
+    /// @brief Constructor.
+    evictor(std::size_t capacity)
+      : capacity_(capacity)
+      , protected_capacity_(capacity * 8 / 10)
+      , probation_()
+      , protected_()
+      , evictions_(0)
+    {}
+
+    /// @brief An entry has been found in the cache.
+    void
+    hit(Entry& e)
+    noexcept
+    {
+      if (e.eviction_hook.is_protected)
+      {
+        protected_.unlink(&e);
+        protected_.push_front(&e);
+        return;
+      }
+
+      probation_.unlink(&e);
+      e.eviction_hook.is_protected = true;
+      protected_.push_front(&e);
+      if (protected_.size > protected_capacity_)
+      {
+        Entry* demoted = protected_.tail;
+        protected_.unlink(demoted);
+        demoted->eviction_hook.is_protected = false;
+        probation_.push_front(demoted);
+      }
+    }
+
+    /// @brief Change the maximal number of entries.
+    void
+    resize(std::size_t capacity)
+    noexcept
+    {
+      capacity_ = capacity;
+      protected_capacity_ = capacity * 8 / 10;
+    }
+
+    /// @brief Evict the least recently used entry of the probationary segment, if the cache is
+    /// full.
+    template <typename Set, typename Erase>
+    bool
+    insert(Entry& e, Set&, Erase&& erase)
+    {
+      bool new_round = false;
+      if (probation_.size + protected_.size >= capacity_)
+      {
+        segment& victims = probation_.size != 0 ? probation_ : protected_;
+        Entry* victim = victims.tail;
+        victims.unlink(victim);
+        erase(victim);
+        if (++evictions_ >= capacity_ / 2)
+        {
+          evictions_ = 0;
+          new_round = true;
+        }
+      }
+      probation_.push_front(&e);
+      return new_round;
+    }
+
+    /// @brief All entries have been removed.
+    void
+    clear()
+    noexcept
+    {
+      probation_ = segment();
+      protected_ = segment();
+      evictions_ = 0;
+    }
+  };
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
+
+#endif // _SDD_MEM_CACHE_EVICTION_HH_
@@ -0,0 +1,408 @@
+#ifndef _SDD_MEM_CONCURRENT_UNIQUE_TABLE_HH_
+#define _SDD_MEM_CONCURRENT_UNIQUE_TABLE_HH_
+
+#include <algorithm>  // max
+#include <atomic>
+#include <cassert>
+#include <cstdint>    // uint64_t
+#include <functional> // hash
+#include <memory>     // unique_ptr
+#include <mutex>
+#include <thread>     // this_thread
+#include <vector>
+
+#include "sdd/mem/hash_table.hh"
+#include "sdd/mem/slab_allocator.hh"
+#include "sdd/mem/unique_table.hh" // unique_table_statistics
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A table to unify data, which can be shared by several threads.
+/// @tparam Set The container of unified data, either hash_table or open_hash_table.
+///
+/// Unified data is dispatched on several shards, using the highest bits of its mixed hash. Each
+/// shard has its own container and mutex, thus threads only contend when they access the same
+/// shard.
+///
+/// Unlike unique_table, the reference returned by operator() is already counted. It's done under
+/// the shard lock, as well as the release of the last reference by erase(): a data can't be
+/// unified by a thread while it's erased by another one. Memory blocks are given by several
+/// slab_allocator, each thread using the one selected by its identifier. Newly unified data is
+/// given increasing identifiers, taken from a single atomic counter.
+///
+/// As with unique_table, data no longer referenced may be kept as dead until the next sweep. A
+/// sweep is triggered by the first thread which sees that the number of dead data has reached the
+/// GC threshold, while other threads keep unifying data.
+template <typename Unique, typename Set = mem::hash_table<Unique>>
+class concurrent_unique_table
+{
+  // Can't copy a concurrent_unique_table.
+  concurrent_unique_table(const concurrent_unique_table&) = delete;
+  concurrent_unique_table& operator=(const concurrent_unique_table&) = delete;
+
+private:
+
+  /// @brief The number of bits of a hash used to select a shard.
+  static constexpr std::size_t shard_bits = 6;
+
+  /// @brief The number of shards.
+  static constexpr std::size_t nb_shards = 1 << shard_bits;
+
+  /// @brief A part of the table, protected by its own mutex.
+  struct shard
+  {
+    /// @brief The actual container of unified data of this shard.
+    Set set;
+
+    /// @brief Protect set and statistics.
+    std::mutex mutex;
+
+    /// @brief The maximum number of stored elements in this shard.
+    std::size_t peak;
+
+    /// @brief The total number of access to this shard.
+    std::size_t access;
+
+    /// @brief The number of hits in this shard.
+    std::size_t hits;
+
+    /// @brief The number of hits on dead data in this shard.
+    std::size_t resurrections;
+
+    /// @brief Constructor.
+    shard(std::size_t initial_size)
+      : set(initial_size, true /* rehash */)
+      , mutex()
+      , peak(0)
+      , access(0)
+      , hits(0)
+      , resurrections(0)
+    {}
+  };
+
+  /// @brief Allocate memory blocks for some threads.
+  struct arena
+  {
+    /// @brief Protect allocator.
+    std::mutex mutex;
+
+    /// @brief The actual allocator.
+    slab_allocator allocator;
+
+    /// @brief Constructor.
+    arena(bool huge_pages)
+      : mutex()
+      , allocator(huge_pages)
+    {}
+  };
+
+  /// @brief The shards.
+  std::vector<std::unique_ptr<shard>> shards_;
+
+  /// @brief The arenas, as many as shards.
+  std::vector<std::unique_ptr<arena>> arenas_;
+
+  /// @brief The number of dead data which triggers a sweep, 0 to erase data at once.
+  std::size_t gc_threshold_;
+
+  /// @brief The number of data no longer referenced, but not yet erased.
+  std::atomic<std::size_t> dead_;
+
+  /// @brief Prevent several threads from sweeping at the same time.
+  mutable std::mutex gc_mutex_;
+
+  /// @brief The number of sweeps, protected by gc_mutex_.
+  std::size_t sweeps_;
+
+  /// @brief The identifier of the next unified data.
+  std::atomic<std::uint64_t> next_id_;
+
+  /// @brief The statistics of this table, computed on demand.
+  mutable unique_table_statistics stats_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param initial_size Initial capacity of the container, shared among all shards.
+  /// @param huge_pages Back the memory of unified data with huge pages, if possible.
+  /// @param gc_threshold The number of dead data which triggers a sweep, 0 to erase data as soon
+  /// as it's no longer referenced.
+  concurrent_unique_table( std::size_t initial_size, bool huge_pages = false
+                         , std::size_t gc_threshold = 0)
+    : shards_()
+    , arenas_()
+    , gc_threshold_(gc_threshold)
+    , dead_(0)
+    , gc_mutex_()
+    , sweeps_(0)
+    , next_id_(0)
+    , stats_()
+  {
+    shards_.reserve(nb_shards);
+    arenas_.reserve(nb_shards);
+    for (std::size_t i = 0; i < nb_shards; ++i)
+    {
+      shards_.emplace_back(new shard(initial_size / nb_shards + 1));
+      arenas_.emplace_back(new arena(huge_pages));
+    }
+  }
+
+  /// @brief Unify a data.
+  /// @param ptr A pointer to a data constructed with a placement new into the storage returned by
+  /// allocate().
+  /// @return A reference to the unified data, with its reference counter already incremented.
+  Unique&
+  operator()(Unique* ptr)
+  {
+    if (gc_threshold_ != 0 and dead_.load(std::memory_order_relaxed) >= gc_threshold_)
+    {
+      std::unique_lock<std::mutex> gc_lock(gc_mutex_, std::try_to_lock);
+      if (gc_lock.owns_lock())
+      {
+        sweep();
+      }
+    }
+
+    shard& s = shard_of(*ptr);
+    Unique* res;
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      ++s.access;
+      auto insertion = s.set.insert(*ptr);
+      res = &*insertion.first;
+      if (insertion.second)
+      {
+        res->set_id(next_id_++);
+        res->increment_reference_counter();
+        s.peak = std::max(s.peak, s.set.size());
+        return *res;
+      }
+      ++s.hits;
+      if (gc_threshold_ != 0 and res->is_not_referenced())
+      {
+        --dead_;
+        ++s.resurrections;
+      }
+      res->increment_reference_counter();
+    }
+    // The inserted Unique already exists.
+    const std::size_t size = sizeof(Unique) + ptr->extra_bytes();
+    ptr->~Unique();
+    deallocate(reinterpret_cast<char*>(ptr), size);
+    return *res;
+  }
+
+  /// @brief Allocate a memory block large enough for the given size.
+  char*
+  allocate(std::size_t extra_bytes)
+  {
+    arena& a = local_arena();
+    std::lock_guard<std::mutex> lock(a.mutex);
+    return a.allocator.allocate(sizeof(Unique) + extra_bytes);
+  }
+
+  /// @brief Release the last reference of the given unified data and erase it, or keep it as dead
+  /// until the next sweep.
+  ///
+  /// Nothing is done if it has been unified again by another thread in the meantime. Otherwise,
+  /// all subsequent uses of the erased data are invalid.
+  void
+  erase(const Unique& x)
+  noexcept
+  {
+    shard& s = shard_of(x);
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      const_cast<Unique&>(x).decrement_reference_counter();
+      if (not x.is_not_referenced())
+      {
+        return;
+      }
+      if (gc_threshold_ != 0 and sweeping() != this)
+      {
+        ++dead_;
+        return;
+      }
+      const auto cit = s.set.find(x);
+      assert(cit != s.set.end() && "Unique not found");
+      s.set.erase(cit);
+    }
+    // The destruction may release other data of this table, thus it's done without the lock.
+    const std::size_t size = sizeof(Unique) + x.extra_bytes();
+    x.~Unique();
+    deallocate(reinterpret_cast<char*>(const_cast<Unique*>(&x)), size);
+  }
+
+  /// @brief Erase all dead data.
+  /// @return The number of erased data.
+  ///
+  /// Data released by erased data is also erased.
+  std::size_t
+  collect()
+  {
+    std::lock_guard<std::mutex> gc_lock(gc_mutex_);
+    return sweep();
+  }
+
+  /// @brief Erase all dead data, then erase data as soon as it's no longer referenced.
+  ///
+  /// Must not be called while other threads use this table.
+  void
+  eager()
+  {
+    collect();
+    gc_threshold_ = 0;
+  }
+
+  /// @brief Get the load factor of the internal hash tables.
+  double
+  load_factor()
+  const
+  {
+    std::size_t size = 0;
+    std::size_t buckets = 0;
+    for (const auto& s : shards_)
+    {
+      std::lock_guard<std::mutex> lock(s->mutex);
+      size += s->set.size();
+      buckets += s->set.bucket_count();
+    }
+    return static_cast<double>(size) / static_cast<double>(buckets);
+  }
+
+  /// @brief Get the statistics of this table.
+  ///
+  /// The peak is the sum of the peaks of all shards, thus it's an upper bound.
+  const unique_table_statistics&
+  stats()
+  const
+  {
+    stats_ = unique_table_statistics();
+    for (const auto& s : shards_)
+    {
+      std::lock_guard<std::mutex> lock(s->mutex);
+      stats_.size += s->set.size();
+      stats_.peak += s->peak;
+      stats_.access += s->access;
+      stats_.hits += s->hits;
+      stats_.resurrections += s->resurrections;
+    }
+    stats_.misses = stats_.access - stats_.hits;
+    stats_.dead = dead_.load();
+    {
+      std::lock_guard<std::mutex> gc_lock(gc_mutex_);
+      stats_.sweeps = sweeps_;
+    }
+    stats_.load_factor = load_factor();
+    return stats_;
+  }
+
+  /// @brief Get the index of the shard of a hash value.
+  ///
+  /// Hashes built on std::hash of integers have their highest bits almost always empty, thus the
+  /// hash is mixed by a multiplication before its highest bits are taken.
+  static
+  std::size_t
+  shard_index(std::size_t hash)
+  noexcept
+  {
+    return (static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull) >> (64 - shard_bits);
+  }
+
+private:
+
+  /// @brief Get the shard of a data.
+  shard&
+  shard_of(const Unique& x)
+  const noexcept
+  {
+    return *shards_[shard_index(std::hash<Unique>()(x))];
+  }
+
+  /// @brief Get the table being swept by the current thread, if any.
+  static
+  const concurrent_unique_table*&
+  sweeping()
+  noexcept
+  {
+    static thread_local const concurrent_unique_table* table = nullptr;
+    return table;
+  }
+
+  /// @brief Erase all dead data, with gc_mutex_ held.
+  ///
+  /// Shards are swept one after the other. Data released by the current thread while it destroys
+  /// dead data is erased at once. Dead data of a shard is gathered before being erased, which may
+  /// allocate.
+  std::size_t
+  sweep()
+  {
+    if (dead_.load() == 0)
+    {
+      return 0;
+    }
+    std::size_t nb_erased = 0;
+    std::vector<const Unique*> dead;
+    dead.reserve(dead_.load());
+    for (auto& s : shards_)
+    {
+      {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        for (const auto& x : s->set)
+        {
+          if (x.is_not_referenced())
+          {
+            dead.push_back(&x);
+          }
+        }
+        for (auto x : dead)
+        {
+          s->set.erase(s->set.find(*x));
+        }
+      }
+      dead_ -= dead.size();
+      nb_erased += dead.size();
+      // The destruction may release other data of this table, thus it's done without the lock.
+      sweeping() = this;
+      for (auto x : dead)
+      {
+        const std::size_t size = sizeof(Unique) + x->extra_bytes();
+        x->~Unique();
+        deallocate(reinterpret_cast<char*>(const_cast<Unique*>(x)), size);
+      }
+      sweeping() = nullptr;
+      dead.clear();
+    }
+    ++sweeps_;
+    return nb_erased;
+  }
+
+  /// @brief Get the arena of the current thread.
+  arena&
+  local_arena()
+  const noexcept
+  {
+    return *arenas_[std::hash<std::thread::id>()(std::this_thread::get_id()) % nb_shards];
+  }
+
+  /// @brief Give back a memory block to the arena of the current thread.
+  ///
+  /// All arenas are destroyed together, thus a block can be released in any of them.
+  void
+  deallocate(char* addr, std::size_t size)
+  noexcept
+  {
+    arena& a = local_arena();
+    std::lock_guard<std::mutex> lock(a.mutex);
+    a.allocator.deallocate(addr, size);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
+
+#endif // _SDD_MEM_CONCURRENT_UNIQUE_TABLE_HH_
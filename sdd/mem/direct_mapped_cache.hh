@@ -0,0 +1,278 @@
+#ifndef _SDD_MEM_DIRECT_MAPPED_CACHE_HH_
+#define _SDD_MEM_DIRECT_MAPPED_CACHE_HH_
+
+#include <algorithm>   // max
+#include <functional>  // hash
+#include <memory>      // unique_ptr
+#include <mutex>       // unique_lock
+#include <new>         // placement new
+#include <string>
+#include <type_traits> // aligned_storage
+#include <utility>     // move
+
+#include "sdd/mem/cache.hh" // apply_filters, cache_statistics
+#include "sdd/mem/interrupt.hh"
+#include "sdd/util/concurrency.hh"
+#include "sdd/util/next_power.hh"
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief  A lossy cache which stores at most one operation per hash value.
+/// @tparam Operation is the operation type.
+/// @tparam EvaluationError is the exception that the evaluation of an Operation can throw.
+/// @tparam Filters is a list of filters that reject some operations.
+///
+/// Entries are stored inline in an array allocated at construction, at the index given by the
+/// lowest bits of the hash of their operation. A new entry simply overwrites the one occupying its
+/// slot, thus no memory is allocated when an operation is inserted and there is no cleanup. It
+/// has the same interface as cache. A new round of statistics starts each time half of the slots
+/// have been overwritten.
+template <typename Context, typename Operation, typename EvaluationError, typename... Filters>
+class direct_mapped_cache
+{
+  // Can't copy a direct_mapped_cache.
+  direct_mapped_cache(const direct_mapped_cache&) = delete;
+  direct_mapped_cache& operator=(const direct_mapped_cache&) = delete;
+
+private:
+
+  /// @brief The type of the context of this cache.
+  using context_type = Context;
+
+  /// @brief The type of the result of an operation stored in the cache.
+  using result_type = typename Operation::result_type;
+
+  /// @brief The storage of an entry, constructed only when it's occupied.
+  struct slot
+  {
+    /// @brief Tell if operation and result are constructed.
+    bool occupied;
+
+    /// @brief The hash of the cached operation.
+    std::size_t hash;
+
+    /// @brief The cached operation.
+    typename std::aligned_storage<sizeof(Operation), alignof(Operation)>::type operation;
+
+    /// @brief The result of the evaluation of operation.
+    typename std::aligned_storage<sizeof(result_type), alignof(result_type)>::type result;
+
+    slot()
+    noexcept
+      : occupied(false)
+      , hash(0)
+    {}
+
+    const Operation&
+    op()
+    const noexcept
+    {
+      return *reinterpret_cast<const Operation*>(&operation);
+    }
+
+    const result_type&
+    res()
+    const noexcept
+    {
+      return *reinterpret_cast<const result_type*>(&result);
+    }
+
+    /// @brief Destroy the stored operation and result, if any.
+    void
+    reset()
+    noexcept
+    {
+      if (occupied)
+      {
+        occupied = false;
+        op().~Operation();
+        res().~result_type();
+      }
+    }
+  };
+
+  /// @brief This cache's context.
+  context_type& cxt_;
+
+  /// @brief The cache name.
+  const std::string name_;
+
+  /// @brief The number of slots, a power of 2.
+  const std::size_t nb_slots_;
+
+  /// @brief The actual storage of caches entries.
+  std::unique_ptr<slot[]> slots_;
+
+  /// @brief The number of occupied slots.
+  std::size_t size_;
+
+  /// @brief The number of overwritten entries since the beginning of the current round.
+  std::size_t overwrites_;
+
+  /// @brief The statistics of this cache.
+  cache_statistics stats_;
+
+  /// @brief Protect the storage and the statistics of this cache.
+  util::mutex mutex_;
+
+public:
+
+  /// @brief Construct a cache.
+  /// @param context This cache's context.
+  /// @param name Give a name to this cache.
+  /// @param size The minimal number of slots, rounded up to the next power of 2.
+  direct_mapped_cache(context_type& context, const std::string& name, std::size_t size)
+    : cxt_(context)
+    , name_(name)
+    , nb_slots_(util::next_power_of_2(std::max<std::size_t>(size, 1)))
+    , slots_(new slot[nb_slots_])
+    , size_(0)
+    , overwrites_(0)
+    , stats_()
+    , mutex_()
+  {}
+
+  /// @brief Destructor.
+  ~direct_mapped_cache()
+  {
+    clear();
+  }
+
+  /// @brief Cache lookup.
+  /// @param op The operation to look up, evaluated if it's not cached.
+  /// @param args Given to the evaluation of op, they are not part of the cached operation.
+  template <typename... Args>
+  result_type
+  operator()(Operation&& op, const Args&... args)
+  {
+    std::unique_lock<util::mutex> lock(mutex_);
+
+    // Check if the current operation should not be cached.
+    if (not apply_filters<Operation, Filters...>()(op))
+    {
+      ++stats_.rounds.front().filtered;
+      lock.unlock();
+      try
+      {
+        return op(cxt_, args...);
+      }
+      catch (EvaluationError& e)
+      {
+        lock.lock();
+        --stats_.rounds.front().filtered;
+        lock.unlock();
+        e.add_step(std::move(op));
+        throw;
+      }
+    }
+
+    const std::size_t hash = std::hash<Operation>()(op);
+    {
+      const slot& s = slots_[hash & (nb_slots_ - 1)];
+      if (s.occupied and s.hash == hash and s.op() == op)
+      {
+        ++stats_.rounds.front().hits;
+        return s.res();
+      }
+    }
+
+    ++stats_.rounds.front().misses;
+
+    // Don't hold the lock while evaluating op, as it may recursively use this cache.
+    lock.unlock();
+    try
+    {
+      result_type result = op(cxt_, args...);
+      lock.lock();
+      // The slot may have been overwritten in the meantime, by a recursive evaluation or by
+      // another thread.
+      slot& s = slots_[hash & (nb_slots_ - 1)];
+      if (s.occupied)
+      {
+        s.reset();
+        --size_;
+        if (++overwrites_ >= nb_slots_ / 2)
+        {
+          overwrites_ = 0;
+          stats_.rounds.emplace_front(cache_statistics::round());
+        }
+      }
+      new (&s.operation) Operation(std::move(op));
+      new (&s.result) result_type(result);
+      s.hash = hash;
+      s.occupied = true;
+      ++size_;
+      return result;
+    }
+    catch (EvaluationError& e)
+    {
+      lock.lock();
+      --stats_.rounds.front().misses;
+      lock.unlock();
+      e.add_step(std::move(op));
+      throw;
+    }
+    catch (interrupt<result_type>&)
+    {
+      lock.lock();
+      --stats_.rounds.front().misses;
+      lock.unlock();
+      throw;
+    }
+  }
+
+  /// @brief The ratio of occupied slots.
+  double
+  load_factor()
+  const noexcept
+  {
+    return static_cast<double>(size_) / static_cast<double>(nb_slots_);
+  }
+
+  /// @brief Remove all entries of the cache.
+  void
+  clear()
+  noexcept
+  {
+    std::lock_guard<util::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < nb_slots_; ++i)
+    {
+      slots_[i].reset();
+    }
+    size_ = 0;
+    overwrites_ = 0;
+  }
+
+  /// @brief Get the number of cached operations.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return size_;
+  }
+
+  /// @brief Get the statistics of this cache.
+  const cache_statistics&
+  statistics()
+  const noexcept
+  {
+    return stats_;
+  }
+
+  /// @brief Get this cache's name
+  const std::string&
+  name()
+  const noexcept
+  {
+    return name_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
+
+#endif // _SDD_MEM_DIRECT_MAPPED_CACHE_HH_
@@ -90,7 +90,8 @@ private:
   increment()
   noexcept
   {
-    if (pos_ != container_->nb_buckets_) // not at the end
+    const std::uint32_t end_pos = container_->end_position();
+    if (pos_ != end_pos) // not at the end
     {
       if (data_->hook.next != nullptr)
       {
@@ -101,15 +102,15 @@ private:
         do // find, if any, next bucket with some data in it
         {
           ++pos_;
-        } while (pos_ < container_->nb_buckets_ and container_->buckets_[pos_] == nullptr);
+        } while (pos_ < end_pos and container_->bucket(pos_) == nullptr);
 
-        if (pos_ == container_->nb_buckets_) // end
+        if (pos_ == end_pos) // end
         {
           data_ = nullptr;
         }
         else // non-empty bucket found
         {
-          data_ = container_->buckets_[pos_];
+          data_ = container_->bucket(pos_);
         }
       }
     }
@@ -140,6 +141,12 @@ private:
 ///
 /// It's modeled after boost::intrusive. Only the interfaces needed by the libsdd are implemented.
 /// It uses chaining to handle collisions.
+///
+/// When constructed with rehash enabled, the table doubles its number of buckets as soon as its
+/// load factor exceeds 0.75. The rehash is incremental: the old buckets are kept alongside the
+/// new ones and a few of them are moved at each insertion, thus no single insertion has to pay
+/// for the whole rehash. An element whose old bucket has not been moved yet is still found in
+/// the old buckets.
 template <typename Data, typename Hash = std::hash<Data>>
 class hash_table
 {
@@ -159,26 +166,54 @@ public:
 
 private:
 
-  // Iterators need to access buckets_.
+  // Iterators need to access buckets.
   friend class hash_table_iterator<Data, hash_table<Data, Hash>>;
   friend class hash_table_iterator<const Data, hash_table<Data, Hash>>;
 
-  /// @brief 
+  /// @brief The number of old buckets moved to the new buckets at each insertion.
+  static constexpr std::uint32_t rehash_steps = 4;
+
+  /// @brief The maximal number of buckets.
+  ///
+  /// Positions of iterators span old and new buckets, they must fit in 32 bits.
+  static constexpr std::uint32_t max_nb_buckets = 1u << 31;
+
+  /// @brief The number of buckets.
   std::uint32_t nb_buckets_;
 
-  /// @brief
+  /// @brief The number of stored elements.
   std::uint32_t size_;
 
-  /// @brief
+  /// @brief The buckets.
   Data** buckets_;
 
+  /// @brief Tell if this hash table is allowed to grow.
+  const bool rehash_;
+
+  /// @brief The number of buckets being moved by an incremental rehash, 0 otherwise.
+  std::uint32_t old_nb_buckets_;
+
+  /// @brief The buckets being moved by an incremental rehash, nullptr otherwise.
+  Data** old_buckets_;
+
+  /// @brief The index of the next old bucket to move.
+  ///
+  /// All old buckets before this index are empty.
+  std::uint32_t rehash_pos_;
+
 public:
 
   /// @brief Constructor
-  hash_table(std::size_t size)
+  /// @param size The initial number of buckets, rounded to the next power of 2.
+  /// @param rehash Tell if this table should grow when its load factor is too high.
+  hash_table(std::size_t size, bool rehash = false)
     : nb_buckets_(util::next_power_of_2(static_cast<std::uint32_t>(size)))
     , size_(0)
     , buckets_(new Data*[nb_buckets_])
+    , rehash_(rehash)
+    , old_nb_buckets_(0)
+    , old_buckets_(nullptr)
+    , rehash_pos_(0)
   {
     std::fill(buckets_, buckets_ + nb_buckets_, nullptr);
   }
@@ -186,6 +221,7 @@ public:
   /// @brief Destructor
   ~hash_table()
   {
+    delete[] old_buckets_;
     delete[] buckets_;
   }
 
@@ -196,10 +232,9 @@ public:
   const noexcept(noexcept(hash(x)))
   {
     commit_data.hash = hash(x);
-    // same as commit_data.h % nb_buckets_, but much more efficient (works only with powers of 2)
-    const std::uint32_t pos = commit_data.hash & (nb_buckets_ - 1);
+    const std::uint32_t pos = position(commit_data.hash);
 
-    Data* current = buckets_[pos];
+    Data* current = bucket(pos);
     bool insertion = true;
 
     while (current != nullptr)
@@ -216,14 +251,17 @@ public:
   }
 
   /// @brief
+  ///
+  /// May allocate memory if a rehash is started.
   void
   insert_commit(Data& x, const insert_commit_data& commit_data)
-  noexcept
   {
-    const std::uint32_t pos = commit_data.hash & (nb_buckets_ - 1);
+    maintain();
+
+    Data*& head = bucket(position(commit_data.hash));
 
     Data* previous = nullptr;
-    Data* current = buckets_[pos];
+    Data* current = head;
 
     while (current != nullptr)
     {
@@ -241,21 +279,24 @@ public:
     }
     else
     {
-      buckets_[pos] = &x;
+      head = &x;
     }
 
     ++size_;
   }
 
   /// @brief Insert an element.
+  ///
+  /// May allocate memory if a rehash is started.
   std::pair<iterator, bool>
   insert(Data& x)
-  noexcept(noexcept(Hash()(x)))
   {
-    const std::uint32_t pos = Hash()(x) & (nb_buckets_ - 1);
+    maintain();
+
+    const std::uint32_t pos = position(Hash()(x));
 
     Data* previous = nullptr;
-    Data* current = buckets_[pos];
+    Data* current = bucket(pos);
     bool insertion = true;
 
     while (current != nullptr)
@@ -277,7 +318,7 @@ public:
       }
       else
       {
-        buckets_[pos] = &x;
+        bucket(pos) = &x;
       }
 
       current = &x;
@@ -296,6 +337,8 @@ public:
   }
 
   /// @brief Return the number of buckets.
+  ///
+  /// During an incremental rehash, it's the number of buckets elements are moved to.
   std::size_t
   bucket_count()
   const noexcept
@@ -303,17 +346,26 @@ public:
     return nb_buckets_;
   }
 
+  /// @brief Tell if an incremental rehash is in progress.
+  bool
+  rehashing()
+  const noexcept
+  {
+    return old_buckets_ != nullptr;
+  }
+
   /// @brief Get an iterator to the beginning of this hash table.
   iterator
   begin()
   noexcept
   {
+    const std::uint32_t end_pos = end_position();
     std::uint32_t pos = 0;
-    while (pos < nb_buckets_ and buckets_[pos] == nullptr)
+    while (pos < end_pos and bucket(pos) == nullptr)
     {
       ++pos;
     }
-    return pos == nb_buckets_ ? end() : iterator(this, pos, buckets_[pos]);
+    return pos == end_pos ? end() : iterator(this, pos, bucket(pos));
   }
 
   /// @brief Get an iterator to the end of this hash table.
@@ -321,7 +373,7 @@ public:
   end()
   noexcept
   {
-    return iterator(this, nb_buckets_, nullptr);
+    return iterator(this, end_position(), nullptr);
   }
 
   /// @brief Find an element.
@@ -329,8 +381,8 @@ public:
   find(const Data& x)
   noexcept
   {
-    const std::uint32_t pos = Hash()(x) & (nb_buckets_ - 1);
-    Data* current = buckets_[pos];
+    const std::uint32_t pos = position(Hash()(x));
+    Data* current = bucket(pos);
     bool found = false;
     while (current != nullptr)
     {
@@ -350,8 +402,9 @@ public:
   erase(const_iterator cit)
   noexcept
   {
+    Data*& head = bucket(cit.pos_);
     Data* previous = nullptr;
-    Data* current = buckets_[cit.pos_];
+    Data* current = head;
     const Data* data = cit.data_;
 
     while (current != data)
@@ -362,7 +415,7 @@ public:
 
     if (previous == nullptr) // first element in bucket
     {
-      buckets_[cit.pos_] = data->hook.next;
+      head = data->hook.next;
     }
     else
     {
@@ -372,6 +425,39 @@ public:
     --size_;
   }
 
+  /// @brief Move all elements to a new array of buckets.
+  /// @param size The new number of buckets, rounded to the next power of 2.
+  ///
+  /// Complete any incremental rehash. Invalidate iterators and insert_commit_data.
+  void
+  rehash(std::size_t size)
+  {
+    const std::uint32_t nb_buckets = util::next_power_of_2(static_cast<std::uint32_t>(size));
+    Data** buckets = new Data*[nb_buckets];
+    std::fill(buckets, buckets + nb_buckets, nullptr);
+
+    for (std::uint32_t pos = 0; pos < end_position(); ++pos)
+    {
+      Data* current = bucket(pos);
+      while (current != nullptr)
+      {
+        Data* next = current->hook.next;
+        const std::uint32_t new_pos = Hash()(*current) & (nb_buckets - 1);
+        current->hook.next = buckets[new_pos];
+        buckets[new_pos] = current;
+        current = next;
+      }
+    }
+
+    delete[] old_buckets_;
+    delete[] buckets_;
+    old_buckets_ = nullptr;
+    old_nb_buckets_ = 0;
+    rehash_pos_ = 0;
+    buckets_ = buckets;
+    nb_buckets_ = nb_buckets;
+  }
+
   /// @brief Clear the whole table.
   template <typename Disposer>
   void
@@ -388,6 +474,100 @@ public:
       disposer(current);
     }
   }
+
+private:
+
+  /// @brief Get the position of the bucket that should contain an element with the given hash.
+  ///
+  /// Positions of old buckets come first, followed by positions of new buckets.
+  std::uint32_t
+  position(std::size_t hash)
+  const noexcept
+  {
+    if (old_buckets_ != nullptr)
+    {
+      // same as hash % old_nb_buckets_, but much more efficient (works only with powers of 2)
+      const std::uint32_t old_pos = hash & (old_nb_buckets_ - 1);
+      if (old_pos >= rehash_pos_) // not moved yet
+      {
+        return old_pos;
+      }
+    }
+    return old_nb_buckets_ + (hash & (nb_buckets_ - 1));
+  }
+
+  /// @brief Get the bucket at a given position.
+  Data*&
+  bucket(std::uint32_t pos)
+  const noexcept
+  {
+    return pos < old_nb_buckets_ ? old_buckets_[pos] : buckets_[pos - old_nb_buckets_];
+  }
+
+  /// @brief Get the position past the last bucket.
+  std::uint32_t
+  end_position()
+  const noexcept
+  {
+    return old_nb_buckets_ + nb_buckets_;
+  }
+
+  /// @brief Start or continue an incremental rehash, if necessary.
+  ///
+  /// Must be called before the position of an element to insert is computed.
+  void
+  maintain()
+  {
+    if (not rehash_)
+    {
+      return;
+    }
+    if (old_buckets_ != nullptr)
+    {
+      rehash_step();
+    }
+    // Load factor above 0.75.
+    else if ( 4 * static_cast<std::size_t>(size_) > 3 * static_cast<std::size_t>(nb_buckets_)
+          and nb_buckets_ < max_nb_buckets)
+    {
+      old_buckets_ = buckets_;
+      old_nb_buckets_ = nb_buckets_;
+      rehash_pos_ = 0;
+      nb_buckets_ *= 2;
+      buckets_ = new Data*[nb_buckets_];
+      std::fill(buckets_, buckets_ + nb_buckets_, nullptr);
+      rehash_step();
+    }
+  }
+
+  /// @brief Move some old buckets to the new buckets.
+  void
+  rehash_step()
+  noexcept
+  {
+    for ( std::uint32_t i = 0; i < rehash_steps and rehash_pos_ < old_nb_buckets_
+        ; ++i, ++rehash_pos_)
+    {
+      Data* current = old_buckets_[rehash_pos_];
+      old_buckets_[rehash_pos_] = nullptr;
+      while (current != nullptr)
+      {
+        Data* next = current->hook.next;
+        const std::uint32_t pos = Hash()(*current) & (nb_buckets_ - 1);
+        current->hook.next = buckets_[pos];
+        buckets_[pos] = current;
+        current = next;
+      }
+    }
+
+    if (rehash_pos_ == old_nb_buckets_) // all old buckets have been moved
+    {
+      delete[] old_buckets_;
+      old_buckets_ = nullptr;
+      old_nb_buckets_ = 0;
+      rehash_pos_ = 0;
+    }
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,363 @@
+#ifndef _SDD_MEM_OPEN_HASH_TABLE_HH_
+#define _SDD_MEM_OPEN_HASH_TABLE_HH_
+
+#include <algorithm>  // fill
+#include <cstdint>    // uint32_t
+#include <functional> // hash
+#include <utility>    // make_pair, pair
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "sdd/util/next_power.hh"
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A slot of an open_hash_table.
+///
+/// The full hash of the data is stored next to its pointer to avoid touching the data when
+/// probing.
+template <typename Data>
+struct open_hash_table_slot
+{
+  /// @brief The hash of the stored data.
+  std::size_t hash;
+
+  /// @brief The stored data, nullptr if this slot is free.
+  Data* data;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A iterator on the open_hash_table.
+template <typename Data, typename HashTable>
+class open_hash_table_iterator
+  : public boost::iterator_facade< open_hash_table_iterator<Data, HashTable>
+                                 , Data, boost::forward_traversal_tag>
+{
+private:
+
+  /// @brief A link to the hash table.
+  const HashTable* container_;
+
+  /// @brief The current position in the slots.
+  std::uint32_t pos_;
+
+public:
+
+  /// @brief Default constructor.
+  open_hash_table_iterator()
+  noexcept
+    : container_(nullptr)
+    , pos_(0)
+  {}
+
+  /// @brief Constructor.
+  explicit open_hash_table_iterator(const HashTable* container, std::uint32_t p)
+  noexcept
+    : container_(container)
+    , pos_(p)
+  {}
+
+  /// @brief Copy constructor from an iterator or a const_iterator.
+  template <typename OtherValue>
+  open_hash_table_iterator(const open_hash_table_iterator<OtherValue, HashTable>& other)
+  noexcept
+    : open_hash_table_iterator(other.container_, other.pos_)
+  {}
+
+private:
+
+  // Required by boost::iterator.
+  friend class boost::iterator_core_access;
+
+  // The hash table need to access internal elements of this iterator.
+  friend HashTable;
+
+  // Friend with const/non-const iterators.
+  template <typename, typename> friend class open_hash_table_iterator;
+
+  /// @brief For boost::iterator.
+  void
+  increment()
+  noexcept
+  {
+    const std::uint32_t nb_slots = container_->nb_slots_;
+    if (pos_ != nb_slots) // not at the end
+    {
+      do // find, if any, next used slot
+      {
+        ++pos_;
+      } while (pos_ < nb_slots and container_->slots_[pos_].data == nullptr);
+    }
+  }
+
+  /// @brief For boost::iterator.
+  template <typename OtherData>
+  bool
+  equal(const open_hash_table_iterator<OtherData, HashTable>& other)
+  const noexcept
+  {
+    return pos_ == other.pos_;
+  }
+
+  /// @brief For boost::iterator.
+  Data&
+  dereference()
+  const noexcept
+  {
+    return *container_->slots_[pos_].data;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief An hash table using open addressing.
+///
+/// It exposes the same interface as hash_table, thus it can be used as the container of a
+/// unique_table. Collisions are handled with linear probing and each slot stores the full hash
+/// of its data: most mismatches while probing are detected without dereferencing the data. Erased
+/// slots are filled by shifting back the following elements of the cluster, thus no tombstone is
+/// needed.
+///
+/// The table is doubled when its load factor exceeds 0.7. As hashes are cached, the data is not
+/// accessed during this rehash.
+template <typename Data, typename Hash = std::hash<Data>>
+class open_hash_table
+{
+  // Can't copy an open_hash_table.
+  open_hash_table(const open_hash_table&) = delete;
+  open_hash_table& operator=(const open_hash_table&) = delete;
+
+public:
+
+  /// @brief The type of an iterator on this hash table.
+  using iterator = open_hash_table_iterator<Data, open_hash_table<Data, Hash>>;
+
+  /// @brief The type of a const iterator on this hash table.
+  using const_iterator = open_hash_table_iterator<const Data, open_hash_table<Data, Hash>>;
+
+private:
+
+  // Iterators need to access slots_.
+  friend class open_hash_table_iterator<Data, open_hash_table<Data, Hash>>;
+  friend class open_hash_table_iterator<const Data, open_hash_table<Data, Hash>>;
+
+  /// @brief The type of a slot.
+  using slot_type = open_hash_table_slot<Data>;
+
+  /// @brief The maximal number of slots.
+  static constexpr std::uint32_t max_nb_slots = 1u << 31;
+
+  /// @brief The number of slots.
+  std::uint32_t nb_slots_;
+
+  /// @brief The number of stored elements.
+  std::uint32_t size_;
+
+  /// @brief The slots.
+  slot_type* slots_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param size The initial number of slots, rounded to the next power of 2.
+  ///
+  /// The second parameter exists for compatibility with hash_table: an open_hash_table always
+  /// grows when it's too loaded.
+  open_hash_table(std::size_t size, bool = true)
+    : nb_slots_(util::next_power_of_2(static_cast<std::uint32_t>(size < 2 ? 2 : size)))
+    , size_(0)
+    , slots_(new slot_type[nb_slots_])
+  {
+    std::fill(slots_, slots_ + nb_slots_, slot_type{0, nullptr});
+  }
+
+  /// @brief Destructor.
+  ~open_hash_table()
+  {
+    delete[] slots_;
+  }
+
+  /// @brief Insert an element.
+  ///
+  /// May allocate memory if the table needs to grow.
+  std::pair<iterator, bool>
+  insert(Data& x)
+  {
+    // Load factor above 0.7.
+    if ( 10 * (static_cast<std::size_t>(size_) + 1) > 7 * static_cast<std::size_t>(nb_slots_)
+        and nb_slots_ < max_nb_slots)
+    {
+      grow();
+    }
+
+    const std::size_t hash = Hash()(x);
+    const std::uint32_t mask = nb_slots_ - 1;
+    std::uint32_t pos = hash & mask;
+
+    while (slots_[pos].data != nullptr)
+    {
+      if (slots_[pos].hash == hash and x == *slots_[pos].data)
+      {
+        return std::make_pair(iterator(this, pos), false);
+      }
+      pos = (pos + 1) & mask;
+    }
+
+    slots_[pos].hash = hash;
+    slots_[pos].data = &x;
+    ++size_;
+    return std::make_pair(iterator(this, pos), true);
+  }
+
+  /// @brief Find an element.
+  iterator
+  find(const Data& x)
+  noexcept
+  {
+    const std::size_t hash = Hash()(x);
+    const std::uint32_t mask = nb_slots_ - 1;
+    std::uint32_t pos = hash & mask;
+
+    while (slots_[pos].data != nullptr)
+    {
+      if (slots_[pos].hash == hash and x == *slots_[pos].data)
+      {
+        return iterator(this, pos);
+      }
+      pos = (pos + 1) & mask;
+    }
+    return end();
+  }
+
+  /// @brief Erase an element given its iterator.
+  void
+  erase(const_iterator cit)
+  noexcept
+  {
+    const std::uint32_t mask = nb_slots_ - 1;
+    std::uint32_t hole = cit.pos_;
+    std::uint32_t current = hole;
+
+    // Shift back elements of the cluster which are not at their home slot.
+    while (true)
+    {
+      current = (current + 1) & mask;
+      if (slots_[current].data == nullptr)
+      {
+        break;
+      }
+      const std::uint32_t home = slots_[current].hash & mask;
+      // Can the element at current be moved to hole? Only if its home slot is not in the
+      // cyclic range ]hole, current].
+      const bool in_range = hole <= current
+                          ? (hole < home and home <= current)
+                          : (hole < home or home <= current);
+      if (not in_range)
+      {
+        slots_[hole] = slots_[current];
+        hole = current;
+      }
+    }
+
+    slots_[hole].data = nullptr;
+    --size_;
+  }
+
+  /// @brief Return the number of elements.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return size_;
+  }
+
+  /// @brief Return the number of slots.
+  std::size_t
+  bucket_count()
+  const noexcept
+  {
+    return nb_slots_;
+  }
+
+  /// @brief Get an iterator to the beginning of this hash table.
+  iterator
+  begin()
+  noexcept
+  {
+    std::uint32_t pos = 0;
+    while (pos < nb_slots_ and slots_[pos].data == nullptr)
+    {
+      ++pos;
+    }
+    return iterator(this, pos);
+  }
+
+  /// @brief Get an iterator to the end of this hash table.
+  iterator
+  end()
+  noexcept
+  {
+    return iterator(this, nb_slots_);
+  }
+
+  /// @brief Clear the whole table.
+  template <typename Disposer>
+  void
+  clear_and_dispose(Disposer disposer)
+  {
+    for (std::uint32_t pos = 0; pos < nb_slots_; ++pos)
+    {
+      Data* data = slots_[pos].data;
+      if (data != nullptr)
+      {
+        slots_[pos].data = nullptr;
+        disposer(data);
+      }
+    }
+    size_ = 0;
+  }
+
+private:
+
+  /// @brief Double the number of slots.
+  ///
+  /// Uses the cached hashes, thus the stored data is never accessed.
+  void
+  grow()
+  {
+    const std::uint32_t old_nb_slots = nb_slots_;
+    slot_type* old_slots = slots_;
+
+    nb_slots_ *= 2;
+    slots_ = new slot_type[nb_slots_];
+    std::fill(slots_, slots_ + nb_slots_, slot_type{0, nullptr});
+
+    const std::uint32_t mask = nb_slots_ - 1;
+    for (std::uint32_t i = 0; i < old_nb_slots; ++i)
+    {
+      if (old_slots[i].data != nullptr)
+      {
+        std::uint32_t pos = old_slots[i].hash & mask;
+        while (slots_[pos].data != nullptr)
+        {
+          pos = (pos + 1) & mask;
+        }
+        slots_[pos] = old_slots[i];
+      }
+    }
+
+    delete[] old_slots;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
+
+#endif // _SDD_MEM_OPEN_HASH_TABLE_HH_
@@ -69,12 +69,16 @@ private:
 public:
 
   /// @brief Constructor with a unified data.
+  ///
+  /// When the library is thread-safe, the unique table has already counted this reference.
   explicit
   ptr(Unique& p)
   noexcept
   	: x_(&p)
   {
+#if not defined LIBSDD_THREAD_SAFE
     x_->increment_reference_counter();
+#endif
   }
 
   /// @brief Copy constructor.
@@ -97,11 +101,19 @@ public:
   /// @brief Destructor.
   ~ptr()
   {
+#if defined LIBSDD_THREAD_SAFE
+    // The last reference is released by the deletion handler.
+    if (not x_->decrement_shared_reference_counter())
+    {
+      deletion_handler<Unique>()(*x_);
+    }
+#else
     x_->decrement_reference_counter();
     if (x_->is_not_referenced())
     {
       deletion_handler<Unique>()(*x_);
     }
+#endif
   }
 
   /// @brief Get a reference to the unified data.
@@ -147,14 +159,15 @@ noexcept
 /// @internal
 /// @related ptr
 ///
-/// O(1).
+/// O(1). Follow the order of unification, rather than the addresses of unified data, so it doesn't
+/// depend on the state of the allocator.
 template <typename Unique>
 inline
 bool
 operator<(const ptr<Unique>& lhs, const ptr<Unique>& rhs)
 noexcept
 {
-  return lhs.operator->() < rhs.operator->();
+  return lhs->id() < rhs->id();
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -167,6 +180,8 @@ namespace std {
 
 /// @internal
 /// @brief Hash specialization for sdd::mem::ptr
+///
+/// Use the hash of the unified data, computed from its content, so it's the same at each run.
 template <typename Unique>
 struct hash<sdd::mem::ptr<Unique>>
 {
@@ -174,7 +189,7 @@ struct hash<sdd::mem::ptr<Unique>>
   operator()(const sdd::mem::ptr<Unique>& x)
   const noexcept
   {
-    return sdd::util::hash(x.operator->());
+    return x->hash();
   }
 };
 
@@ -2,11 +2,14 @@
 #define _SDD_MEM_REF_COUNTED_HH_
 
 #include <cassert>
-#include <cstdint>     // uint32_t
+#if defined LIBSDD_THREAD_SAFE
+#include <atomic>
+#endif
+#include <cstdint>     // uint32_t, uint64_t
 #include <functional>  // hash
 #include <limits>      // numeric_limits
 #include <type_traits> // is_nothrow_constructible
-#include <utility>     // forward
+#include <utility>     // declval, forward
 
 #include "sdd/util/packed.hh"
 
@@ -47,8 +50,24 @@ private:
 
   /// @brief The number of time the encapsulated data is referenced
   ///
-  /// Implements a reference-counting garbage collection.
+  /// Implements a reference-counting garbage collection. It's atomic when the library is
+  /// thread-safe.
+#if defined LIBSDD_THREAD_SAFE
+  std::atomic<std::uint32_t> ref_count_;
+#else
   std::uint32_t ref_count_;
+#endif
+
+  /// @brief The hash of the data, computed once at construction.
+  ///
+  /// As data hash the unified data they reference through ptr with this value rather than with
+  /// their addresses, it only depends on the structure of the data.
+  std::size_t hash_;
+
+  /// @brief Identify this unified data among all the others of the same unique table.
+  ///
+  /// Given at unification, in increasing order.
+  std::uint64_t id_;
 
   /// @brief The garbage collected data.
   ///
@@ -60,11 +79,17 @@ public:
   
   template <typename... Args>
   ref_counted(Args&&... args)
-  noexcept(std::is_nothrow_constructible<T, Args...>::value)
+  noexcept( std::is_nothrow_constructible<T, Args...>::value
+          and noexcept(Hash()(std::declval<const T&>())))
     : hook()
     , ref_count_(0)
+    , hash_(0)
+    , id_(0)
     , data_(std::forward<Args>(args)...)
-  {}
+  {
+    // data_ is the last field, its hash can only be computed once it's constructed.
+    hash_ = Hash()(data_);
+  }
 
   /// @brief Get a reference of the unified data.
   const T&
@@ -74,6 +99,26 @@ public:
     return data_;
   }
 
+  /// @brief Get the hash of the unified data.
+  ///
+  /// O(1).
+  std::size_t
+  hash()
+  const noexcept
+  {
+    return hash_;
+  }
+
+  /// @brief Get the unique identifier given to the data at its unification.
+  ///
+  /// O(1).
+  std::uint64_t
+  id()
+  const noexcept
+  {
+    return id_;
+  }
+
   /// @brief Get the number of extra bytes that may be used by the contained type.
   ///
   /// This information is needed when a data of variable length is allocated.
@@ -124,6 +169,21 @@ private:
   // hash_table needs to access the hook.
   template <typename, typename> friend class hash_table;
 
+  // unique_table gives identifiers.
+  template <typename, typename> friend class unique_table;
+
+  // concurrent_unique_table counts and releases references under its locks, and gives
+  // identifiers.
+  template <typename, typename> friend class concurrent_unique_table;
+
+  /// @brief Set the identifier of the unified data.
+  void
+  set_id(std::uint64_t id)
+  noexcept
+  {
+    id_ = id;
+  }
+
   /// @brief A ptr references that unified data.
   void
   increment_reference_counter()
@@ -141,6 +201,28 @@ private:
     assert(ref_count_ > 0);
     --ref_count_;
   }
+
+#if defined LIBSDD_THREAD_SAFE
+  /// @brief A ptr no longer references that unified data, unless it's the last reference.
+  /// @return false if the counter was left untouched because it's the last reference.
+  ///
+  /// The last reference is released by the concurrent_unique_table, under its lock: this way,
+  /// another thread can't unify again a data which is being erased.
+  bool
+  decrement_shared_reference_counter()
+  noexcept
+  {
+    std::uint32_t count = ref_count_.load(std::memory_order_relaxed);
+    while (count > 1)
+    {
+      if (ref_count_.compare_exchange_weak(count, count - 1))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+#endif
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -171,9 +253,9 @@ struct hash<sdd::mem::ref_counted<T,Hash>>
 {
   std::size_t
   operator()(const sdd::mem::ref_counted<T, Hash>& x)
-  const noexcept(noexcept(Hash()(x.data())))
+  const noexcept
   {
-    return Hash()(x.data());
+    return x.hash();
   }
 };
 
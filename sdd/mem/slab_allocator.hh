@@ -0,0 +1,196 @@
+#ifndef _SDD_MEM_SLAB_ALLOCATOR_HH_
+#define _SDD_MEM_SLAB_ALLOCATOR_HH_
+
+#include <cstddef> // max_align_t
+#include <cstdlib> // free, posix_memalign
+#include <new>     // bad_alloc
+#include <vector>
+
+#include <sys/mman.h> // madvise
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Allocate memory blocks of a few sizes in large pages.
+///
+/// Sizes are rounded up to a multiple of the maximal alignment, each multiple being a size class
+/// with its own free list. A block is taken from the free list of its class or, if it's empty,
+/// carved at the end of the current page: blocks allocated one after the other are contiguous,
+/// whatever their sizes. Released blocks are kept in free lists, pages are only given back to the
+/// system at destruction. Both allocation and release are in O(1).
+///
+/// Blocks larger than max_block_size are directly allocated with new.
+class slab_allocator
+{
+  // Can't copy a slab_allocator.
+  slab_allocator(const slab_allocator&) = delete;
+  slab_allocator& operator=(const slab_allocator&) = delete;
+
+public:
+
+  /// @brief The alignment of all blocks.
+  static constexpr std::size_t alignment = alignof(std::max_align_t);
+
+  /// @brief The largest size of a block allocated in pages.
+  static constexpr std::size_t max_block_size = 4096;
+
+  /// @brief The default size of a page.
+  static constexpr std::size_t default_page_size = 1 << 20;
+
+  /// @brief The size of a page when backed by huge pages.
+  static constexpr std::size_t huge_page_size = 2 << 20;
+
+private:
+
+  /// @brief A released block, linked to the next one of the same size class.
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  /// @brief The size of each page.
+  const std::size_t page_size_;
+
+  /// @brief Tell if pages should be backed by huge pages.
+  const bool huge_pages_;
+
+  /// @brief All allocated pages.
+  std::vector<char*> pages_;
+
+  /// @brief The next free byte of the current page.
+  char* current_;
+
+  /// @brief The end of the current page.
+  char* end_;
+
+  /// @brief A list of released blocks per size class.
+  std::vector<free_block*> free_lists_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param huge_pages Ask the system to back pages with huge pages, when it's supported.
+  slab_allocator(bool huge_pages = false)
+    : page_size_(huge_pages ? huge_page_size : default_page_size)
+    , huge_pages_(huge_pages)
+    , pages_()
+    , current_(nullptr)
+    , end_(nullptr)
+    , free_lists_(max_block_size / alignment + 1, nullptr)
+  {}
+
+  /// @brief Destructor.
+  ///
+  /// All blocks allocated in pages are released at once.
+  ~slab_allocator()
+  {
+    for (auto page : pages_)
+    {
+      std::free(page);
+    }
+  }
+
+  /// @brief Allocate a block of at least the given size.
+  char*
+  allocate(std::size_t size)
+  {
+    if (size > max_block_size)
+    {
+      return new char[size];
+    }
+    const std::size_t size_class = class_of(size);
+    free_block*& head = free_lists_[size_class];
+    if (head != nullptr)
+    {
+      free_block* b = head;
+      head = b->next;
+      return reinterpret_cast<char*>(b);
+    }
+    const std::size_t block_size = size_class * alignment;
+    if (static_cast<std::size_t>(end_ - current_) < block_size)
+    {
+      new_page();
+    }
+    char* addr = current_;
+    current_ += block_size;
+    return addr;
+  }
+
+  /// @brief Release a block.
+  /// @param size The size given to allocate() for this block.
+  void
+  deallocate(char* addr, std::size_t size)
+  noexcept
+  {
+    if (size > max_block_size)
+    {
+      delete[] addr;
+      return;
+    }
+    free_block*& head = free_lists_[class_of(size)];
+    free_block* b = reinterpret_cast<free_block*>(addr);
+    b->next = head;
+    head = b;
+  }
+
+  /// @brief Get the number of bytes allocated in pages.
+  std::size_t
+  capacity()
+  const noexcept
+  {
+    return pages_.size() * page_size_;
+  }
+
+private:
+
+  /// @brief Get the size class of a size.
+  static
+  std::size_t
+  class_of(std::size_t size)
+  noexcept
+  {
+    return size == 0 ? 1 : (size + alignment - 1) / alignment;
+  }
+
+  /// @brief Allocate a new page.
+  ///
+  /// The remaining space of the current page is put in the free list of its size class.
+  void
+  new_page()
+  {
+    const std::size_t remaining = static_cast<std::size_t>(end_ - current_);
+    if (remaining >= alignment)
+    {
+      deallocate(current_, remaining);
+    }
+
+    // Make sure the page can be registered before allocating it.
+    if (pages_.size() == pages_.capacity())
+    {
+      pages_.reserve(2 * pages_.size() + 1);
+    }
+    void* page;
+    if (posix_memalign(&page, huge_pages_ ? huge_page_size : alignment, page_size_) != 0)
+    {
+      throw std::bad_alloc();
+    }
+#if defined MADV_HUGEPAGE
+    if (huge_pages_)
+    {
+      // Only a hint, the page is still usable if the system doesn't follow it.
+      madvise(page, page_size_, MADV_HUGEPAGE);
+    }
+#endif
+    pages_.push_back(static_cast<char*>(page));
+    current_ = static_cast<char*>(page);
+    end_ = current_ + page_size_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
+
+#endif // _SDD_MEM_SLAB_ALLOCATOR_HH_
@@ -2,9 +2,11 @@
 #define _SDD_MEM_UNIQUE_TABLE_HH_
 
 #include <cassert>
+#include <cstdint> // uint64_t
+#include <vector>
 
 #include "sdd/mem/hash_table.hh"
-#include "sdd/util/boost_flat_map_no_warnings.hh"
+#include "sdd/mem/slab_allocator.hh"
 
 namespace sdd { namespace mem {
 
@@ -32,6 +34,15 @@ struct unique_table_statistics
 
   /// @brief The number of misses.
   std::size_t misses;
+
+  /// @brief The number of data no longer referenced, but not yet erased.
+  std::size_t dead;
+
+  /// @brief The number of hits on data no longer referenced.
+  std::size_t resurrections;
+
+  /// @brief The number of sweeps of dead data.
+  std::size_t sweeps;
 };
 
 } // namespace anonymous
@@ -40,7 +51,15 @@ struct unique_table_statistics
 
 /// @internal
 /// @brief A table to unify data.
-template <typename Unique>
+/// @tparam Set The container of unified data, either hash_table or open_hash_table.
+///
+/// Unified data is stored in memory blocks given by a slab_allocator. Each newly unified data is
+/// given an identifier greater than all the previous ones.
+///
+/// Data no longer referenced is either erased at once or, if a GC threshold is given, kept as dead
+/// in the table: it's resurrected if it's unified again before the next sweep. A sweep happens
+/// when the number of dead data reaches the threshold, or when collect() is called.
+template <typename Unique, typename Set = mem::hash_table<Unique>>
 class unique_table
 {
   // Can't copy a unique_table.
@@ -50,37 +69,44 @@ class unique_table
 private:
 
   /// @brief The actual container of unified data.
-  mem::hash_table<Unique> set_;
+  Set set_;
 
   /// @brief The statistics of this unique_table.
   mutable unique_table_statistics stats_;
 
-  /// @brief Index re-usable memory blocks by size.
-  boost::container::flat_multimap<std::size_t, char*> blocks_;
+  /// @brief Allocate the memory blocks of unified data.
+  slab_allocator allocator_;
+
+  /// @brief The number of dead data which triggers a sweep, 0 to erase data at once.
+  std::size_t gc_threshold_;
 
-  /// @brief The number of re-usable memory blocks to keep.
-  static constexpr std::size_t nb_blocks = 4096;
+  /// @brief The number of data no longer referenced, but not yet erased.
+  std::size_t dead_;
+
+  /// @brief Tell if a sweep is in progress, in which case released data is erased at once.
+  bool sweeping_;
+
+  /// @brief The identifier of the next unified data.
+  std::uint64_t next_id_;
 
 public:
 
   /// @brief Constructor.
   /// @param initial_size Initial capacity of the container.
-  unique_table(std::size_t initial_size)
-    : set_(initial_size)
+  /// @param huge_pages Back the memory of unified data with huge pages, if possible.
+  /// @param gc_threshold The number of dead data which triggers a sweep, 0 to erase data as soon
+  /// as it's no longer referenced.
+  ///
+  /// The container grows incrementally when its load factor becomes too high.
+  unique_table(std::size_t initial_size, bool huge_pages = false, std::size_t gc_threshold = 0)
+    : set_(initial_size, true /* rehash */)
     , stats_()
-    , blocks_()
-  {
-    blocks_.reserve(nb_blocks);
-  }
-
-  /// @brief Destructor.
-  ~unique_table()
-  {
-    for (auto& b : blocks_)
-    {
-      delete[] b.second;
-    }
-  }
+    , allocator_(huge_pages)
+    , gc_threshold_(gc_threshold)
+    , dead_(0)
+    , sweeping_(false)
+    , next_id_(0)
+  {}
 
   /// @brief Unify a data.
   /// @param ptr A pointer to a data constructed with a placement new into the storage returned by
@@ -89,29 +115,32 @@ public:
   Unique&
   operator()(Unique* ptr)
   {
+    if (gc_threshold_ != 0 and dead_ >= gc_threshold_)
+    {
+      collect();
+    }
+
     ++stats_.access;
 
     auto insertion = set_.insert(*ptr);
     if (not insertion.second)
     {
-      // The inserted Unique already exists. We keep its allocated memory to avoid deallocating
-      // memory each time there is a hit.
+      // The inserted Unique already exists.
       ++stats_.hits;
-      const std::size_t size = sizeof(Unique) + ptr->extra_bytes();
-      ptr->~Unique();
-      if (blocks_.size() == nb_blocks)
+      if (gc_threshold_ != 0 and insertion.first->is_not_referenced())
       {
-        // Erase last block (the biggest one).
-        auto it = blocks_.end() - 1;
-        delete[] it->second;
-        blocks_.erase(it);
+        --dead_;
+        ++stats_.resurrections;
       }
-      blocks_.emplace(size, reinterpret_cast<char*>(ptr));
+      const std::size_t size = sizeof(Unique) + ptr->extra_bytes();
+      ptr->~Unique();
+      allocator_.deallocate(reinterpret_cast<char*>(ptr), size);
     }
     else
     {
       ++stats_.misses;
       stats_.peak = std::max(stats_.peak, set_.size());
+      ptr->set_id(next_id_++);
     }
     return *insertion.first;
   }
@@ -120,22 +149,10 @@ public:
   char*
   allocate(std::size_t extra_bytes)
   {
-    const std::size_t size = sizeof(Unique) + extra_bytes;
-    const auto it = blocks_.lower_bound(size);
-    if (it != blocks_.end() and it->first <= (2 * size))
-    {
-      // re-use allocated blocks
-      char* addr = it->second;
-      blocks_.erase(it);
-      return addr;
-    }
-    else
-    {
-      return new char[size];
-    }
+    return allocator_.allocate(sizeof(Unique) + extra_bytes);
   }
 
-  /// @brief Erase the given unified data.
+  /// @brief Erase the given unified data, or keep it as dead until the next sweep.
   ///
   /// All subsequent uses of the erased data are invalid.
   void
@@ -143,11 +160,52 @@ public:
   noexcept
   {
     assert(x.is_not_referenced() && "Unique still referenced");
-    const auto cit = set_.find(x);
-    assert(cit != set_.end() && "Unique not found");
-    set_.erase(cit);
-    x.~Unique();
-    delete[] reinterpret_cast<const char*>(&x); // match new char[] of allocate().
+    if (gc_threshold_ != 0 and not sweeping_)
+    {
+      ++dead_;
+      return;
+    }
+    erase_now(x);
+  }
+
+  /// @brief Erase all dead data.
+  /// @return The number of erased data.
+  ///
+  /// Data released by erased data is also erased. Dead data is gathered before being erased, as
+  /// erasing it can release other data while the table is traversed; this may allocate.
+  std::size_t
+  collect()
+  {
+    if (dead_ == 0)
+    {
+      return 0;
+    }
+    std::vector<const Unique*> dead;
+    dead.reserve(dead_);
+    for (const auto& x : set_)
+    {
+      if (x.is_not_referenced())
+      {
+        dead.push_back(&x);
+      }
+    }
+    sweeping_ = true;
+    for (auto x : dead)
+    {
+      erase_now(*x);
+    }
+    sweeping_ = false;
+    dead_ = 0;
+    ++stats_.sweeps;
+    return dead.size();
+  }
+
+  /// @brief Erase all dead data, then erase data as soon as it's no longer referenced.
+  void
+  eager()
+  {
+    collect();
+    gc_threshold_ = 0;
   }
 
   /// @brief Get the load factor of the internal hash table.
@@ -165,8 +223,24 @@ public:
   {
     stats_.size = set_.size();
     stats_.load_factor = load_factor();
+    stats_.dead = dead_;
     return stats_;
   }
+
+private:
+
+  /// @brief Actually erase the given unified data.
+  void
+  erase_now(const Unique& x)
+  noexcept
+  {
+    const auto cit = set_.find(x);
+    assert(cit != set_.end() && "Unique not found");
+    set_.erase(cit);
+    const std::size_t size = sizeof(Unique) + x.extra_bytes();
+    x.~Unique();
+    allocator_.deallocate(reinterpret_cast<char*>(const_cast<Unique*>(&x)), size);
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
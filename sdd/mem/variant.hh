@@ -231,7 +231,7 @@ inline
 typename Visitor::result_type
 visit(const Visitor& v, const X& x, Args&&... args)
 {
-  return apply_visitor(v, *x, x.env(), std::forward<Args>(args)...);
+  return apply_visitor(v, *x, x, std::forward<Args>(args)...);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -243,7 +243,7 @@ inline
 typename Visitor::result_type
 visit_self(const Visitor& v, const X& x, Args&&... args)
 {
-  return apply_visitor(v, *x, x.env(), x, std::forward<Args>(args)...);
+  return apply_visitor(v, *x, x, x, std::forward<Args>(args)...);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -255,7 +255,7 @@ inline
 typename Visitor::result_type
 binary_visit(const Visitor& v, const X& x, const Y& y, Args&&... args)
 {
-  return apply_binary_visitor(v, *x, *y, x.env(), y.env(), std::forward<Args>(args)...);
+  return apply_binary_visitor(v, *x, *y, x, y, std::forward<Args>(args)...);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -267,7 +267,7 @@ inline
 typename Visitor::result_type
 binary_visit_self(const Visitor& v, const X& x, const Y& y, Args&&... args)
 {
-  return apply_binary_visitor(v, *x, *y, x.env(), y.env(), x, y, std::forward<Args>(args)...);
+  return apply_binary_visitor(v, *x, *y, x, y, x, y, std::forward<Args>(args)...);
 }
 
 /*------------------------------------------------------------------------------------------------*/
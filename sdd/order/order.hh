@@ -167,13 +167,19 @@ public:
   }
 
   /// @internal
+  ///
+  /// Consistent with operator==, which compares orders structurally: two orders built separately
+  /// from the same builder have the same hash.
   std::size_t
   hash()
   const noexcept
   {
-    std::size_t seed = 0;
-    util::hash_combine(seed, nodes_ptr_.get());
-    util::hash_combine(seed, head_);
+    if (empty())
+    {
+      return 0;
+    }
+    std::size_t seed = util::hash(position());
+    util::hash_combine(seed, identifier());
     return seed;
   }
 
@@ -4,6 +4,7 @@
 #include "sdd/conf/default_configurations.hh"
 #include "sdd/dd/context.hh"
 #include "sdd/dd/definition.hh"
+#include "sdd/hom/compile.hh"
 #include "sdd/hom/context.hh"
 #include "sdd/hom/definition.hh"
 #include "sdd/hom/rewrite.hh"
@@ -0,0 +1,752 @@
+#ifndef _SDD_TOOLS_BINARY_HH_
+#define _SDD_TOOLS_BINARY_HH_
+
+#include <algorithm>   // sort
+#include <cstdint>     // uint8_t, uint64_t
+#include <cstring>     // memcmp
+#include <fstream>
+#include <iosfwd>
+#include <limits>      // numeric_limits
+#include <stdexcept>   // runtime_error
+#include <string>
+#include <type_traits> // is_integral, is_unsigned
+#include <unordered_map>
+#include <utility>     // pair
+#include <vector>
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+
+#include "sdd/internal_manager.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/dd/proto_node.hh"
+#include "sdd/util/hash.hh"
+#include "sdd/util/next_power.hh"
+#include "sdd/values/values_traits.hh"
+
+namespace sdd { namespace tools {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Describe the binary format of SDD.
+///
+/// All integers are unsigned LEB128 varints. A file is made of:
+/// - the magic "SDDB" and the version of the format;
+/// - the sets of values: their number, then for each one its size followed by its values,
+///   encoded as differences with the previous value;
+/// - the nodes: their number, then for each one its number of arcs followed by each arc's
+///   values set identifier, values stack and successors stack;
+/// - the environments: their number, then for each one its level, values stack and successors
+///   stack;
+/// - the roots: their number, then for each one its environment and node identifiers.
+///
+/// A stack is written as its number of elements followed by its elements; successors are
+/// written as node identifiers. Identifiers 0 and 1 are respectively |0| and |1|, then nodes
+/// are numbered from 2 in the order they are written, which is such that a node comes after all
+/// the nodes it references.
+namespace binary {
+
+static constexpr char magic[4] = {'S', 'D', 'D', 'B'};
+static constexpr std::uint64_t version = 1;
+
+/// @internal
+inline
+void
+write(std::ostream& os, std::uint64_t x)
+{
+  while (x >= 0x80)
+  {
+    os.put(static_cast<char>((x & 0x7f) | 0x80));
+    x >>= 7;
+  }
+  os.put(static_cast<char>(x));
+}
+
+/// @internal
+/// @brief Read a varint from a memory buffer.
+class reader
+{
+private:
+
+  const std::uint8_t* cit_;
+  const std::uint8_t* end_;
+
+public:
+
+  reader(const char* data, std::size_t size)
+  noexcept
+    : cit_(reinterpret_cast<const std::uint8_t*>(data))
+    , end_(cit_ + size)
+  {}
+
+  std::uint64_t
+  read()
+  {
+    std::uint64_t x = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+      if (cit_ == end_)
+      {
+        throw std::runtime_error("Truncated SDD binary data.");
+      }
+      const std::uint8_t byte = *cit_++;
+      x |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if (not (byte & 0x80))
+      {
+        return x;
+      }
+    }
+    throw std::runtime_error("Invalid varint in SDD binary data.");
+  }
+
+  /// @brief Read an identifier which must be lower than a bound.
+  std::uint64_t
+  read_id(std::uint64_t bound)
+  {
+    const auto id = read();
+    if (id >= bound)
+    {
+      throw std::runtime_error("Invalid identifier in SDD binary data.");
+    }
+    return id;
+  }
+
+  /// @brief Read a value which must fit in a given unsigned type.
+  template <typename T>
+  T
+  read_value()
+  {
+    const auto x = read();
+    if (x > std::numeric_limits<T>::max())
+    {
+      throw std::runtime_error("Invalid value in SDD binary data.");
+    }
+    return static_cast<T>(x);
+  }
+
+  /// @brief Read a number of elements which are still to be read.
+  ///
+  /// As each element takes at least one byte, a greater number can only come from corrupted data.
+  std::uint64_t
+  read_count()
+  {
+    const auto count = read();
+    if (count > static_cast<std::uint64_t>(end_ - cit_))
+    {
+      throw std::runtime_error("Invalid count in SDD binary data.");
+    }
+    return count;
+  }
+
+  bool
+  match_magic()
+  {
+    if (static_cast<std::size_t>(end_ - cit_) < sizeof(magic)
+        or std::memcmp(cit_, magic, sizeof(magic)) != 0)
+    {
+      return false;
+    }
+    cit_ += sizeof(magic);
+    return true;
+  }
+};
+
+} // namespace binary
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Write SDD in the binary format.
+///
+/// Nodes, environments and sets of values shared by several SDD are written only once.
+template <typename C>
+class binary_writer
+{
+private:
+
+  using ptr_type = sdd_ptr_type<C>;
+  using unique_type = sdd_unique_type<C>;
+  using env_type = typename SDD<C>::proto_env_type;
+  using values_type = typename C::Values;
+  using value_type = typename values_type::value_type;
+
+  static_assert( std::is_integral<value_type>::value and std::is_unsigned<value_type>::value
+               , "Binary serialization requires unsigned integral values.");
+
+  /// @brief The identifiers of already visited nodes.
+  std::unordered_map<const unique_type*, std::uint64_t> nodes_ids_;
+
+  /// @brief The nodes to write, in a topological order.
+  std::vector<const proto_node<C>*> nodes_;
+
+  std::unordered_map<values_type, std::uint64_t> values_ids_;
+  std::vector<values_type> values_;
+
+  std::unordered_map<env_type, std::uint64_t> envs_ids_;
+  std::vector<env_type> envs_;
+
+  /// @brief The environment and node identifiers of each added SDD.
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> roots_;
+
+public:
+
+  /// @brief Add an SDD to write.
+  void
+  add(const SDD<C>& x)
+  {
+    const auto node = node_id(x.ptr());
+    const auto env = env_id(x.env());
+    roots_.emplace_back(env, node);
+  }
+
+  /// @brief Write all added SDD.
+  void
+  write(std::ostream& os)
+  const
+  {
+    os.write(binary::magic, sizeof(binary::magic));
+    binary::write(os, binary::version);
+
+    binary::write(os, values_.size());
+    for (const auto& values : values_)
+    {
+      binary::write(os, values.size());
+      value_type previous = 0;
+      for (const auto& v : values)
+      {
+        binary::write(os, v - previous);
+        previous = v;
+      }
+    }
+
+    binary::write(os, nodes_.size());
+    for (const auto node : nodes_)
+    {
+      binary::write(os, node->size());
+      for (const auto& arc : *node)
+      {
+        binary::write(os, values_ids_.find(arc.current_values)->second);
+        write_values_stack(os, arc.values);
+        write_successors_stack(os, arc.successors);
+      }
+    }
+
+    binary::write(os, envs_.size());
+    for (const auto& env : envs_)
+    {
+      binary::write(os, env.level());
+      write_values_stack(os, env.values_stack());
+      write_successors_stack(os, env.successors_stack());
+    }
+
+    binary::write(os, roots_.size());
+    for (const auto& root : roots_)
+    {
+      binary::write(os, root.first);
+      binary::write(os, root.second);
+    }
+  }
+
+private:
+
+  /// @brief Visit a node after all the nodes it references.
+  std::uint64_t
+  node_id(const ptr_type& ptr)
+  {
+    if (ptr == SDD<C>::zero_ptr())
+    {
+      return 0;
+    }
+    if (ptr == SDD<C>::one_ptr())
+    {
+      return 1;
+    }
+    const auto search = nodes_ids_.find(&*ptr);
+    if (search != nodes_ids_.end())
+    {
+      return search->second;
+    }
+    const auto& node = mem::variant_cast<proto_node<C>>(ptr->data());
+    for (const auto& arc : node)
+    {
+      values_id(arc.current_values);
+      for (const auto& succ : arc.successors.elements)
+      {
+        node_id(succ);
+      }
+    }
+    const std::uint64_t id = nodes_.size() + 2;
+    nodes_ids_.emplace(&*ptr, id);
+    nodes_.push_back(&node);
+    return id;
+  }
+
+  void
+  values_id(const values_type& values)
+  {
+    if (values_ids_.emplace(values, values_.size()).second)
+    {
+      values_.push_back(values);
+    }
+  }
+
+  std::uint64_t
+  env_id(const env_type& env)
+  {
+    for (const auto& succ : env.successors_stack().elements)
+    {
+      node_id(succ);
+    }
+    const auto insertion = envs_ids_.emplace(env, envs_.size());
+    if (insertion.second)
+    {
+      envs_.push_back(env);
+    }
+    return insertion.first->second;
+  }
+
+  static
+  void
+  write_values_stack(std::ostream& os, const dd::stack<value_type>& s)
+  {
+    binary::write(os, s.elements.size());
+    for (const auto& v : s.elements)
+    {
+      binary::write(os, v);
+    }
+  }
+
+  void
+  write_successors_stack(std::ostream& os, const dd::stack<ptr_type>& s)
+  const
+  {
+    binary::write(os, s.elements.size());
+    for (const auto& succ : s.elements)
+    {
+      if (succ == SDD<C>::zero_ptr())
+      {
+        binary::write(os, 0);
+      }
+      else if (succ == SDD<C>::one_ptr())
+      {
+        binary::write(os, 1);
+      }
+      else
+      {
+        binary::write(os, nodes_ids_.find(&*succ)->second);
+      }
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Rebuild SDD from the binary format.
+///
+/// Nodes are unified bottom-up in the unique table of the running manager, thus loaded SDD are
+/// the same as the ones built by operations.
+template <typename C>
+class binary_loader
+{
+private:
+
+  using ptr_type = sdd_ptr_type<C>;
+  using unique_type = sdd_unique_type<C>;
+  using env_type = typename SDD<C>::proto_env_type;
+  using values_type = typename C::Values;
+  using value_type = typename values_type::value_type;
+
+  binary::reader reader_;
+  std::vector<values_type> values_;
+  std::vector<ptr_type> nodes_;
+  std::vector<env_type> envs_;
+
+  /// @brief The nodes already checked, with the level they were checked at.
+  ///
+  /// It's an open-addressing set with linear probing: no allocation is made for each node. Empty
+  /// slots have a null node.
+  std::vector<std::pair<const unique_type*, unsigned int>> checked_;
+
+  /// @brief The number of nodes in checked_.
+  std::size_t nb_checked_;
+
+public:
+
+  binary_loader(const char* data, std::size_t size)
+    : reader_(data, size), values_(), nodes_(), envs_(), checked_(), nb_checked_(0)
+  {}
+
+  std::vector<SDD<C>>
+  load()
+  {
+    if (not reader_.match_magic() or reader_.read() != binary::version)
+    {
+      throw std::runtime_error("Not an SDD binary file.");
+    }
+
+    const auto nb_values = reader_.read_count();
+    values_.reserve(nb_values);
+    for (std::uint64_t i = 0; i < nb_values; ++i)
+    {
+      typename values::values_traits<values_type>::builder builder;
+      const auto size = reader_.read_count();
+      builder.reserve(size);
+      value_type v = 0;
+      for (std::uint64_t j = 0; j < size; ++j)
+      {
+        // Values are strictly increasing: only the first difference can be 0.
+        const auto delta = reader_.read_value<value_type>();
+        if ((j != 0 and delta == 0) or delta > std::numeric_limits<value_type>::max() - v)
+        {
+          throw std::runtime_error("Invalid set of values in SDD binary data.");
+        }
+        v += delta;
+        builder.insert(builder.end(), v);
+      }
+      values_.emplace_back(std::move(builder));
+    }
+
+    const auto nb_nodes = reader_.read_count();
+    nodes_.reserve(nb_nodes + 2);
+    nodes_.push_back(SDD<C>::zero_ptr());
+    nodes_.push_back(SDD<C>::one_ptr());
+    auto& ut = global<C>().sdd_unique_table;
+    for (std::uint64_t i = 0; i < nb_nodes; ++i)
+    {
+      const auto nb_arcs = reader_.read_count();
+      if (nb_arcs == 0)
+      {
+        throw std::runtime_error("Node without arcs in SDD binary data.");
+      }
+      typename proto_node<C>::arcs_type arcs;
+      arcs.reserve(nb_arcs);
+      for (std::uint64_t j = 0; j < nb_arcs; ++j)
+      {
+        auto& current_values = values_[reader_.read_id(values_.size())];
+        if (current_values.empty())
+        {
+          throw std::runtime_error("Arc with empty values in SDD binary data.");
+        }
+        auto values_stack = read_values_stack();
+        auto successors_stack = read_successors_stack();
+        arcs.emplace_back( values_type(current_values), std::move(values_stack)
+                         , std::move(successors_stack));
+      }
+      // Arcs are sorted by the order of their successors, which is not the same as when they
+      // were written.
+      std::sort(arcs.begin(), arcs.end());
+      char* addr = ut.allocate(0 /* extra bytes */);
+      unique_type* u = new (addr) unique_type(mem::construct<proto_node<C>>(), std::move(arcs));
+      nodes_.emplace_back(ut(u));
+    }
+
+    const auto nb_envs = reader_.read_count();
+    envs_.reserve(nb_envs);
+    for (std::uint64_t i = 0; i < nb_envs; ++i)
+    {
+      const auto level = reader_.read_value<unsigned int>();
+      auto values_stack = read_values_stack();
+      auto successors_stack = read_successors_stack();
+      envs_.emplace_back(level, std::move(values_stack), std::move(successors_stack));
+    }
+
+    // Most nodes are checked at a single level.
+    checked_.resize(util::next_power_of_2(2 * nodes_.size()));
+
+    const auto nb_roots = reader_.read_count();
+    std::vector<SDD<C>> res;
+    res.reserve(nb_roots);
+    for (std::uint64_t i = 0; i < nb_roots; ++i)
+    {
+      const auto& env = envs_[reader_.read_id(envs_.size())];
+      const auto& node = nodes_[reader_.read_id(nodes_.size())];
+      check_root(env, node);
+      res.emplace_back(node, env);
+    }
+    return res;
+  }
+
+private:
+
+  /// @brief Check that a root can be decoded: its node must fit the levels given by its
+  /// environment.
+  void
+  check_root(const env_type& env, const ptr_type& node)
+  {
+    if (node == SDD<C>::zero_ptr() or node == SDD<C>::one_ptr())
+    {
+      if (env.level() != 0 or not env.values_stack().elements.empty()
+          or not env.successors_stack().elements.empty())
+      {
+        throw std::runtime_error("Inconsistent environment in SDD binary data.");
+      }
+      return;
+    }
+    check_stacks(env.level(), env.values_stack(), env.successors_stack());
+    check_node(node, env.level());
+  }
+
+  /// @brief Check that a node can be decoded at a given level.
+  ///
+  /// |1| is at level 0, a node is above it. Successors are recorded on stacks, the i-th one being
+  /// i levels below the direct successor; |0| is the default element of these stacks.
+  void
+  check_node(const ptr_type& ptr, unsigned int level)
+  {
+    if (ptr == SDD<C>::zero_ptr())
+    {
+      return;
+    }
+    if ((ptr == SDD<C>::one_ptr()) != (level == 0))
+    {
+      throw std::runtime_error("Inconsistent levels in SDD binary data.");
+    }
+    if (level == 0 or not insert_checked(&*ptr, level))
+    {
+      return;
+    }
+    for (const auto& arc : mem::variant_cast<proto_node<C>>(ptr->data()))
+    {
+      check_stacks(level, arc.values, arc.successors);
+    }
+  }
+
+  /// @brief Check the stacks of a node at a given level, then the successors they record.
+  void
+  check_stacks( unsigned int level, const dd::stack<value_type>& values
+              , const dd::stack<ptr_type>& successors)
+  {
+    if (values.elements.size() > level or successors.elements.size() > level)
+    {
+      throw std::runtime_error("Inconsistent levels in SDD binary data.");
+    }
+    for (std::size_t i = 0; i < successors.elements.size(); ++i)
+    {
+      check_node(successors.elements[i], level - 1 - static_cast<unsigned int>(i));
+    }
+  }
+
+  /// @brief Record that a node is checked at a given level.
+  /// @return false if it was already checked at this level.
+  bool
+  insert_checked(const unique_type* u, unsigned int level)
+  {
+    if (2 * (nb_checked_ + 1) > checked_.size())
+    {
+      std::vector<std::pair<const unique_type*, unsigned int>> old(2 * checked_.size());
+      std::swap(old, checked_);
+      for (const auto& x : old)
+      {
+        if (x.first != nullptr)
+        {
+          checked_[find_checked(x.first, x.second)] = x;
+        }
+      }
+    }
+    const auto pos = find_checked(u, level);
+    if (checked_[pos].first != nullptr)
+    {
+      return false;
+    }
+    checked_[pos] = std::make_pair(u, level);
+    ++nb_checked_;
+    return true;
+  }
+
+  /// @brief Get the slot of a node checked at a given level, or the empty slot where to put it.
+  std::size_t
+  find_checked(const unique_type* u, unsigned int level)
+  const noexcept
+  {
+    std::size_t seed = util::hash(u);
+    util::hash_combine(seed, level);
+    // Addresses of nodes have their lowest bits alike, thus the highest bits of a mixed hash are
+    // taken. There are at least 4 slots.
+    const std::size_t mask = checked_.size() - 1;
+    const auto bits = static_cast<unsigned int>(__builtin_ctzll(checked_.size()));
+    const std::uint64_t mixed = static_cast<std::uint64_t>(seed) * 0x9e3779b97f4a7c15ull;
+    for (std::size_t pos = mixed >> (64 - bits);; pos = (pos + 1) & mask)
+    {
+      if (checked_[pos].first == nullptr
+          or (checked_[pos].first == u and checked_[pos].second == level))
+      {
+        return pos;
+      }
+    }
+  }
+
+  dd::stack<value_type>
+  read_values_stack()
+  {
+    dd::stack<value_type> s;
+    const auto size = reader_.read_count();
+    s.elements.reserve(size);
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+      s.elements.push_back(reader_.read_value<value_type>());
+    }
+    return s;
+  }
+
+  dd::stack<ptr_type>
+  read_successors_stack()
+  {
+    dd::stack<ptr_type> s;
+    const auto size = reader_.read_count();
+    s.elements.reserve(size);
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+      s.elements.push_back(nodes_[reader_.read_id(nodes_.size())]);
+    }
+    return s;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A read-only memory mapping of a whole file.
+class mapped_file
+{
+  // Can't copy a mapped_file.
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+private:
+
+  void* data_;
+  std::size_t size_;
+
+public:
+
+  mapped_file(const std::string& path)
+    : data_(nullptr)
+    , size_(0)
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::runtime_error("Can't open " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+      ::close(fd);
+      throw std::runtime_error("Can't stat " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ != 0)
+    {
+      data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (data_ == MAP_FAILED)
+    {
+      throw std::runtime_error("Can't map " + path);
+    }
+#if defined MADV_SEQUENTIAL
+    if (data_)
+    {
+      ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+#endif
+  }
+
+  ~mapped_file()
+  {
+    if (data_)
+    {
+      ::munmap(data_, size_);
+    }
+  }
+
+  const char*
+  data()
+  const noexcept
+  {
+    return static_cast<const char*>(data_);
+  }
+
+  std::size_t
+  size()
+  const noexcept
+  {
+    return size_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Write SDD to a stream in a compact binary format.
+///
+/// Nodes and sets of values shared by several SDD are written only once.
+template <typename C>
+void
+save_binary(std::ostream& os, const std::vector<SDD<C>>& xs)
+{
+  binary_writer<C> writer;
+  for (const auto& x : xs)
+  {
+    writer.add(x);
+  }
+  writer.write(os);
+}
+
+/// @brief Write an SDD to a stream in a compact binary format.
+template <typename C>
+void
+save_binary(std::ostream& os, const SDD<C>& x)
+{
+  save_binary(os, std::vector<SDD<C>>{x});
+}
+
+/// @brief Write SDD to a file in a compact binary format.
+template <typename C>
+void
+save_binary(const std::string& path, const std::vector<SDD<C>>& xs)
+{
+  std::ofstream os(path, std::ios::binary);
+  if (not os)
+  {
+    throw std::runtime_error("Can't open " + path);
+  }
+  save_binary(os, xs);
+  os.close();
+  if (not os)
+  {
+    throw std::runtime_error("Can't write " + path);
+  }
+}
+
+/// @brief Read SDD from a memory buffer in the binary format.
+/// @throw std::runtime_error if the buffer is not valid binary data.
+///
+/// The SDD are unified in the running manager.
+template <typename C>
+std::vector<SDD<C>>
+load_binary(const char* data, std::size_t size)
+{
+  return binary_loader<C>(data, size).load();
+}
+
+/// @brief Read SDD from a file in the binary format.
+/// @throw std::runtime_error if the file can't be read or is not a valid binary file.
+///
+/// The file is mapped in memory for the time of the loading.
+template <typename C>
+std::vector<SDD<C>>
+load_binary(const std::string& path)
+{
+  const mapped_file file(path);
+  return load_binary<C>(file.data(), file.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::tools
+
+#endif // _SDD_TOOLS_BINARY_HH_
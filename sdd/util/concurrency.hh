@@ -0,0 +1,56 @@
+#ifndef _SDD_UTIL_CONCURRENCY_HH_
+#define _SDD_UTIL_CONCURRENCY_HH_
+
+#include <mutex>
+
+/*------------------------------------------------------------------------------------------------*/
+
+#if defined LIBSDD_THREAD_SAFE
+#  define LIBSDD_THREAD_LOCAL thread_local
+#else
+#  define LIBSDD_THREAD_LOCAL
+#endif
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace sdd { namespace util {
+
+#if defined LIBSDD_THREAD_SAFE
+
+/// @internal
+/// @brief The mutex protecting structures shared by all threads.
+using mutex = std::mutex;
+
+#else
+
+/// @internal
+/// @brief A mutex which does nothing, used when the library is not thread-safe.
+///
+/// It satisfies the Lockable concept, thus it can be used with std::unique_lock.
+struct mutex
+{
+  void
+  lock()
+  noexcept
+  {}
+
+  bool
+  try_lock()
+  noexcept
+  {
+    return true;
+  }
+
+  void
+  unlock()
+  noexcept
+  {}
+};
+
+#endif // LIBSDD_THREAD_SAFE
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::util
+
+#endif // _SDD_UTIL_CONCURRENCY_HH_
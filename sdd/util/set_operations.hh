@@ -0,0 +1,802 @@
+#ifndef _SDD_UTIL_SET_OPERATIONS_HH_
+#define _SDD_UTIL_SET_OPERATIONS_HH_
+
+#include <algorithm> // copy, lower_bound, min, unique
+#include <cstddef>   // size_t
+#include <cstdint>   // uint32_t
+
+#if not defined LIBSDD_NO_SIMD and defined __GNUC__ and (defined __x86_64__ or defined __i386__)
+#  define LIBSDD_SIMD_X86
+#  define LIBSDD_TARGET(isa) __attribute__((target(isa)))
+#  include <immintrin.h>
+#endif
+
+namespace sdd { namespace util {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The instruction sets used by the operations on sorted arrays of 32 bits integers.
+enum class simd_level {none, sse42, avx2};
+
+/// @internal
+/// @brief The number of elements operations may write past their result.
+///
+/// Vectorized kernels store whole registers, thus output buffers must have this room in addition
+/// to the maximal size of the result.
+constexpr std::size_t set_operations_padding = 8;
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Ask the running CPU the best instruction set it supports.
+inline
+simd_level
+detect_simd_level()
+noexcept
+{
+#if defined LIBSDD_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return simd_level::avx2;
+  }
+  if (__builtin_cpu_supports("sse4.2"))
+  {
+    return simd_level::sse42;
+  }
+#endif
+  return simd_level::none;
+}
+
+/// @internal
+/// @brief Get the best instruction set supported by the running CPU.
+///
+/// Detected once, the first time it's called.
+inline
+simd_level
+detected_simd_level()
+noexcept
+{
+  static const simd_level level = detect_simd_level();
+  return level;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace detail {
+
+/// @internal
+/// @brief Operations switch to galloping when an operand is this many times larger than the other.
+constexpr std::size_t gallop_ratio = 32;
+
+/// @internal
+/// @brief The merge network of the union is used when operands have at least this many elements.
+///
+/// Below, a scalar merge is faster as its branches are well predicted.
+constexpr std::size_t union_network_threshold = 2048;
+
+/// @internal
+/// @brief Get the index of the first element of a sorted array which is not lower than x.
+///
+/// Exponential search, then binary search: O(log i) where i is the returned index.
+template <typename T>
+inline
+std::size_t
+gallop(const T* first, std::size_t n, const T& x)
+noexcept
+{
+  std::size_t lo = 0;
+  std::size_t step = 1;
+  while (lo + step < n and first[lo + step] < x)
+  {
+    lo += step;
+    step *= 2;
+  }
+  return std::lower_bound(first + lo, first + std::min(lo + step, n), x) - first;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+template <typename T>
+inline
+std::size_t
+union_scalar(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+noexcept
+{
+  std::size_t i = 0, j = 0, k = 0;
+  while (i < na and j < nb)
+  {
+    if (a[i] < b[j])
+    {
+      out[k++] = a[i++];
+    }
+    else if (b[j] < a[i])
+    {
+      out[k++] = b[j++];
+    }
+    else
+    {
+      out[k++] = a[i++];
+      ++j;
+    }
+  }
+  k = std::copy(a + i, a + na, out + k) - out;
+  return std::copy(b + j, b + nb, out + k) - out;
+}
+
+/// @internal
+/// @brief Union of a small sorted array with a large one.
+///
+/// Runs of the large array are located by galloping and copied as a whole.
+template <typename T>
+inline
+std::size_t
+union_gallop(const T* small, std::size_t ns, const T* large, std::size_t nl, T* out)
+noexcept
+{
+  std::size_t j = 0;
+  T* o = out;
+  for (std::size_t i = 0; i < ns; ++i)
+  {
+    const auto run = gallop(large + j, nl - j, small[i]);
+    o = std::copy(large + j, large + j + run, o);
+    j += run;
+    if (j < nl and not (small[i] < large[j]))
+    {
+      ++j; // Same value.
+    }
+    *o++ = small[i];
+  }
+  return std::copy(large + j, large + nl, o) - out;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+template <typename T>
+inline
+std::size_t
+intersection_scalar(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+noexcept
+{
+  std::size_t i = 0, j = 0, k = 0;
+  while (i < na and j < nb)
+  {
+    if (a[i] < b[j])
+    {
+      ++i;
+    }
+    else if (b[j] < a[i])
+    {
+      ++j;
+    }
+    else
+    {
+      out[k++] = a[i++];
+      ++j;
+    }
+  }
+  return k;
+}
+
+/// @internal
+/// @brief Intersection of a small sorted array with a large one.
+template <typename T>
+inline
+std::size_t
+intersection_gallop(const T* small, std::size_t ns, const T* large, std::size_t nl, T* out)
+noexcept
+{
+  std::size_t j = 0, k = 0;
+  for (std::size_t i = 0; i < ns and j < nl; ++i)
+  {
+    j += gallop(large + j, nl - j, small[i]);
+    if (j < nl and not (small[i] < large[j]))
+    {
+      out[k++] = small[i];
+      ++j;
+    }
+  }
+  return k;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+template <typename T>
+inline
+std::size_t
+difference_scalar(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+noexcept
+{
+  std::size_t i = 0, j = 0, k = 0;
+  while (i < na and j < nb)
+  {
+    if (a[i] < b[j])
+    {
+      out[k++] = a[i++];
+    }
+    else if (b[j] < a[i])
+    {
+      ++j;
+    }
+    else
+    {
+      ++i;
+      ++j;
+    }
+  }
+  return std::copy(a + i, a + na, out + k) - out;
+}
+
+/// @internal
+/// @brief Difference of a small sorted array and a large one.
+template <typename T>
+inline
+std::size_t
+difference_gallop_small(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+noexcept
+{
+  std::size_t j = 0, k = 0;
+  for (std::size_t i = 0; i < na; ++i)
+  {
+    j += gallop(b + j, nb - j, a[i]);
+    if (j < nb and not (a[i] < b[j]))
+    {
+      ++j;
+    }
+    else
+    {
+      out[k++] = a[i];
+    }
+  }
+  return k;
+}
+
+/// @internal
+/// @brief Difference of a large sorted array and a small one.
+///
+/// Runs of the large array are located by galloping and copied as a whole.
+template <typename T>
+inline
+std::size_t
+difference_gallop_large(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+noexcept
+{
+  std::size_t i = 0;
+  T* o = out;
+  for (std::size_t j = 0; j < nb and i < na; ++j)
+  {
+    const auto run = gallop(a + i, na - i, b[j]);
+    o = std::copy(a + i, a + i + run, o);
+    i += run;
+    if (i < na and not (b[j] < a[i]))
+    {
+      ++i;
+    }
+  }
+  return std::copy(a + i, a + na, o) - out;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+#if defined LIBSDD_SIMD_X86
+
+/// @internal
+/// @brief Shuffle masks which move the 32 bits lanes selected by a 4 bits mask to the front.
+inline
+const std::uint8_t*
+compact_shuffle(unsigned int mask)
+noexcept
+{
+  alignas(16) static const std::uint8_t table[16][16] =
+    { { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 0,  1,  2,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 4,  5,  6,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 0,  1,  2,  3,  4,  5,  6,  7,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 8,  9, 10, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 0,  1,  2,  3,  8,  9, 10, 11,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 4,  5,  6,  7,  8,  9, 10, 11,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,  0,  0,  0,  0}
+    , {12, 13, 14, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 0,  1,  2,  3, 12, 13, 14, 15,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 4,  5,  6,  7, 12, 13, 14, 15,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 0,  1,  2,  3,  4,  5,  6,  7, 12, 13, 14, 15,  0,  0,  0,  0}
+    , { 8,  9, 10, 11, 12, 13, 14, 15,  0,  0,  0,  0,  0,  0,  0,  0}
+    , { 0,  1,  2,  3,  8,  9, 10, 11, 12, 13, 14, 15,  0,  0,  0,  0}
+    , { 4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,  0,  0,  0,  0}
+    , { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15}
+    };
+  return table[mask];
+}
+
+/// @internal
+/// @brief Store the lanes of v selected by mask at out.
+/// @return The number of stored lanes.
+LIBSDD_TARGET("sse4.2")
+inline
+std::size_t
+store_compact(std::uint32_t* out, __m128i v, unsigned int mask)
+noexcept
+{
+  const auto shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(compact_shuffle(mask)));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(v, shuffle));
+  return static_cast<std::size_t>(__builtin_popcount(mask));
+}
+
+/// @internal
+/// @brief Get the mask of lanes of va equal to a lane of vb.
+LIBSDD_TARGET("sse4.2")
+inline
+unsigned int
+match(__m128i va, __m128i vb)
+noexcept
+{
+  const auto r0 = _mm_cmpeq_epi32(va, vb);
+  const auto r1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+  const auto r2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+  const auto r3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+  const auto r = _mm_or_si128(_mm_or_si128(r0, r1), _mm_or_si128(r2, r3));
+  return static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(r)));
+}
+
+/// @internal
+/// @brief Get the mask of lanes of va equal to a lane of vb.
+LIBSDD_TARGET("avx2")
+inline
+unsigned int
+match(__m256i va, __m256i vb)
+noexcept
+{
+  const auto rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  auto r = _mm256_cmpeq_epi32(va, vb);
+  for (int i = 1; i < 8; ++i)
+  {
+    vb = _mm256_permutevar8x32_epi32(vb, rotate);
+    r = _mm256_or_si256(r, _mm256_cmpeq_epi32(va, vb));
+  }
+  return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(r)));
+}
+
+/// @internal
+/// @brief Store the lanes of v selected by mask at out.
+/// @return The number of stored lanes.
+LIBSDD_TARGET("avx2")
+inline
+std::size_t
+store_compact(std::uint32_t* out, __m256i v, unsigned int mask)
+noexcept
+{
+  const auto k = store_compact(out, _mm256_castsi256_si128(v), mask & 0xF);
+  return k + store_compact(out + k, _mm256_extracti128_si256(v, 1), mask >> 4);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Sort a bitonic sequence of 4 integers.
+LIBSDD_TARGET("sse4.2")
+inline
+__m128i
+bitonic_sort(__m128i x)
+noexcept
+{
+  auto t = _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+  x = _mm_blend_epi16(_mm_min_epu32(x, t), _mm_max_epu32(x, t), 0xF0);
+  t = _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm_blend_epi16(_mm_min_epu32(x, t), _mm_max_epu32(x, t), 0xCC);
+}
+
+/// @internal
+/// @brief Merge two sorted vectors: lo gets the 4 lowest integers, hi the 4 highest.
+LIBSDD_TARGET("sse4.2")
+inline
+void
+bitonic_merge(__m128i& lo, __m128i& hi)
+noexcept
+{
+  const auto reversed = _mm_shuffle_epi32(hi, _MM_SHUFFLE(0, 1, 2, 3));
+  const auto l = _mm_min_epu32(lo, reversed);
+  const auto h = _mm_max_epu32(lo, reversed);
+  lo = bitonic_sort(l);
+  hi = bitonic_sort(h);
+}
+
+/// @internal
+/// @brief Union with a merge network, 4 integers at a time.
+///
+/// The output of the network is sorted, thus an integer present in both operands appears in two
+/// consecutive lanes; the second one is dropped when stored.
+LIBSDD_TARGET("sse4.2")
+inline
+std::size_t
+union_sse42( const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb
+           , std::uint32_t* out)
+noexcept
+{
+  if (na < 4 or nb < 4)
+  {
+    return union_scalar(a, na, b, nb, out);
+  }
+  auto pending = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+  auto next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+  std::size_t i = 4, j = 4, k = 0;
+  // The first stored lane has no predecessor.
+  auto last = _mm_set1_epi32(-1);
+  unsigned int first = 1;
+  while (true)
+  {
+    bitonic_merge(next, pending);
+    const auto previous = _mm_alignr_epi8(next, last, 12);
+    const auto duplicates = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(next, previous)));
+    k += store_compact(out + k, next, (~static_cast<unsigned int>(duplicates) & 0xF) | first);
+    first = 0;
+    last = next;
+    // Load from the operand whose next integer is the lowest.
+    const bool from_a = j == nb or (i < na and a[i] <= b[j]);
+    if (from_a ? i + 4 > na : j + 4 > nb)
+    {
+      break;
+    }
+    next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from_a ? a + i : b + j));
+    (from_a ? i : j) += 4;
+  }
+  // Merge the pending integers with the remaining ones; all of them are not lower than the last
+  // stored integer.
+  alignas(16) std::uint32_t tmp[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(tmp), pending);
+  // The pending integers may contain an integer of both operands.
+  const std::size_t ntmp = std::unique(tmp, tmp + 4) - tmp;
+  const std::uint32_t previous = static_cast<std::uint32_t>(_mm_extract_epi32(last, 3));
+  const bool from_a = j == nb or (i < na and a[i] <= b[j]);
+  const std::uint32_t* tail = from_a ? a + i : b + j;
+  const std::size_t tail_size = from_a ? na - i : nb - j;
+  std::uint32_t head[4 + 4];
+  const auto nhead = union_scalar(tmp, ntmp, tail, tail_size, head);
+  const std::size_t skip = head[0] == previous ? 1 : 0;
+  const std::uint32_t* rest = from_a ? b + j : a + i;
+  const std::size_t rest_size = from_a ? nb - j : na - i;
+  return k + union_scalar(head + skip, nhead - skip, rest, rest_size, out + k);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Intersection by blocks of 4 integers, compared all against all.
+LIBSDD_TARGET("sse4.2")
+inline
+std::size_t
+intersection_sse42( const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb
+                  , std::uint32_t* out)
+noexcept
+{
+  std::size_t i = 0, j = 0, k = 0;
+  while (i + 4 <= na and j + 4 <= nb)
+  {
+    const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+    k += store_compact(out + k, va, match(va, vb));
+    const auto amax = a[i + 3];
+    const auto bmax = b[j + 3];
+    i += amax <= bmax ? 4 : 0;
+    j += bmax <= amax ? 4 : 0;
+  }
+  return k + intersection_scalar(a + i, na - i, b + j, nb - j, out + k);
+}
+
+/// @internal
+/// @brief Intersection by blocks of 8 integers, compared all against all.
+LIBSDD_TARGET("avx2")
+inline
+std::size_t
+intersection_avx2( const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb
+                 , std::uint32_t* out)
+noexcept
+{
+  std::size_t i = 0, j = 0, k = 0;
+  while (i + 8 <= na and j + 8 <= nb)
+  {
+    const auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    k += store_compact(out + k, va, match(va, vb));
+    const auto amax = a[i + 7];
+    const auto bmax = b[j + 7];
+    i += amax <= bmax ? 8 : 0;
+    j += bmax <= amax ? 8 : 0;
+  }
+  return k + intersection_sse42(a + i, na - i, b + j, nb - j, out + k);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Difference by blocks of 4 integers, compared all against all.
+///
+/// The integers of a block of a are stored once compared with all blocks of b which may contain
+/// them.
+LIBSDD_TARGET("sse4.2")
+inline
+std::size_t
+difference_sse42( const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb
+                , std::uint32_t* out)
+noexcept
+{
+  std::size_t i = 0, j = 0, k = 0;
+  unsigned int matched = 0;
+  while (i + 4 <= na and j + 4 <= nb)
+  {
+    const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+    matched |= match(va, vb);
+    const auto amax = a[i + 3];
+    const auto bmax = b[j + 3];
+    if (amax <= bmax)
+    {
+      k += store_compact(out + k, va, ~matched & 0xF);
+      matched = 0;
+      i += 4;
+    }
+    j += bmax <= amax ? 4 : 0;
+  }
+  if (matched != 0)
+  {
+    // The current block of a was partially compared.
+    std::uint32_t candidates[4];
+    std::size_t n = 0;
+    for (std::size_t l = 0; l < 4; ++l)
+    {
+      if (not (matched & (1u << l)))
+      {
+        candidates[n++] = a[i + l];
+      }
+    }
+    k += difference_scalar(candidates, n, b + j, nb - j, out + k);
+    i += 4;
+  }
+  return k + difference_scalar(a + i, na - i, b + j, nb - j, out + k);
+}
+
+/// @internal
+/// @brief Difference by blocks of 8 integers, compared all against all.
+LIBSDD_TARGET("avx2")
+inline
+std::size_t
+difference_avx2( const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb
+               , std::uint32_t* out)
+noexcept
+{
+  std::size_t i = 0, j = 0, k = 0;
+  unsigned int matched = 0;
+  while (i + 8 <= na and j + 8 <= nb)
+  {
+    const auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    matched |= match(va, vb);
+    const auto amax = a[i + 7];
+    const auto bmax = b[j + 7];
+    if (amax <= bmax)
+    {
+      k += store_compact(out + k, va, ~matched & 0xFF);
+      matched = 0;
+      i += 8;
+    }
+    j += bmax <= amax ? 8 : 0;
+  }
+  if (matched != 0)
+  {
+    std::uint32_t candidates[8];
+    std::size_t n = 0;
+    for (std::size_t l = 0; l < 8; ++l)
+    {
+      if (not (matched & (1u << l)))
+      {
+        candidates[n++] = a[i + l];
+      }
+    }
+    k += difference_scalar(candidates, n, b + j, nb - j, out + k);
+    i += 8;
+  }
+  return k + difference_sse42(a + i, na - i, b + j, nb - j, out + k);
+}
+
+#endif // LIBSDD_SIMD_X86
+
+} // namespace detail
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Union of two sorted arrays without duplicates.
+/// @param out Must have room for na + nb + set_operations_padding elements.
+/// @return The number of elements written to out.
+template <typename T>
+inline
+std::size_t
+set_union(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+noexcept
+{
+  if (na > detail::gallop_ratio * nb)
+  {
+    return detail::union_gallop(b, nb, a, na, out);
+  }
+  if (nb > detail::gallop_ratio * na)
+  {
+    return detail::union_gallop(a, na, b, nb, out);
+  }
+  return detail::union_scalar(a, na, b, nb, out);
+}
+
+/// @internal
+/// @brief Union of two sorted arrays of 32 bits integers, with a given instruction set.
+///
+/// The merge network uses SSE4.2 instructions, thus AVX2 brings nothing more. It only pays off
+/// for large operands.
+inline
+std::size_t
+set_union( simd_level level, const std::uint32_t* a, std::size_t na, const std::uint32_t* b
+         , std::size_t nb, std::uint32_t* out)
+noexcept
+{
+  if (na > detail::gallop_ratio * nb)
+  {
+    return detail::union_gallop(b, nb, a, na, out);
+  }
+  if (nb > detail::gallop_ratio * na)
+  {
+    return detail::union_gallop(a, na, b, nb, out);
+  }
+#if defined LIBSDD_SIMD_X86
+  if (level != simd_level::none and na + nb >= detail::union_network_threshold)
+  {
+    return detail::union_sse42(a, na, b, nb, out);
+  }
+#endif
+  (void)level;
+  return detail::union_scalar(a, na, b, nb, out);
+}
+
+/// @internal
+inline
+std::size_t
+set_union( const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb
+         , std::uint32_t* out)
+noexcept
+{
+  return set_union(detected_simd_level(), a, na, b, nb, out);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Intersection of two sorted arrays without duplicates.
+/// @param out Must have room for min(na, nb) + set_operations_padding elements.
+/// @return The number of elements written to out.
+template <typename T>
+inline
+std::size_t
+set_intersection(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+noexcept
+{
+  if (na > detail::gallop_ratio * nb)
+  {
+    return detail::intersection_gallop(b, nb, a, na, out);
+  }
+  if (nb > detail::gallop_ratio * na)
+  {
+    return detail::intersection_gallop(a, na, b, nb, out);
+  }
+  return detail::intersection_scalar(a, na, b, nb, out);
+}
+
+/// @internal
+/// @brief Intersection of two sorted arrays of 32 bits integers, with a given instruction set.
+inline
+std::size_t
+set_intersection( simd_level level, const std::uint32_t* a, std::size_t na
+                , const std::uint32_t* b, std::size_t nb, std::uint32_t* out)
+noexcept
+{
+  if (na > detail::gallop_ratio * nb)
+  {
+    return detail::intersection_gallop(b, nb, a, na, out);
+  }
+  if (nb > detail::gallop_ratio * na)
+  {
+    return detail::intersection_gallop(a, na, b, nb, out);
+  }
+#if defined LIBSDD_SIMD_X86
+  switch (level)
+  {
+    case simd_level::avx2:
+      return detail::intersection_avx2(a, na, b, nb, out);
+    case simd_level::sse42:
+      return detail::intersection_sse42(a, na, b, nb, out);
+    case simd_level::none:
+      break;
+  }
+#endif
+  (void)level;
+  return detail::intersection_scalar(a, na, b, nb, out);
+}
+
+/// @internal
+inline
+std::size_t
+set_intersection( const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb
+                , std::uint32_t* out)
+noexcept
+{
+  return set_intersection(detected_simd_level(), a, na, b, nb, out);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Difference of two sorted arrays without duplicates.
+/// @param out Must have room for na + set_operations_padding elements.
+/// @return The number of elements written to out.
+template <typename T>
+inline
+std::size_t
+set_difference(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+noexcept
+{
+  if (na > detail::gallop_ratio * nb)
+  {
+    return detail::difference_gallop_large(a, na, b, nb, out);
+  }
+  if (nb > detail::gallop_ratio * na)
+  {
+    return detail::difference_gallop_small(a, na, b, nb, out);
+  }
+  return detail::difference_scalar(a, na, b, nb, out);
+}
+
+/// @internal
+/// @brief Difference of two sorted arrays of 32 bits integers, with a given instruction set.
+inline
+std::size_t
+set_difference( simd_level level, const std::uint32_t* a, std::size_t na
+              , const std::uint32_t* b, std::size_t nb, std::uint32_t* out)
+noexcept
+{
+  if (na > detail::gallop_ratio * nb)
+  {
+    return detail::difference_gallop_large(a, na, b, nb, out);
+  }
+  if (nb > detail::gallop_ratio * na)
+  {
+    return detail::difference_gallop_small(a, na, b, nb, out);
+  }
+#if defined LIBSDD_SIMD_X86
+  switch (level)
+  {
+    case simd_level::avx2:
+      return detail::difference_avx2(a, na, b, nb, out);
+    case simd_level::sse42:
+      return detail::difference_sse42(a, na, b, nb, out);
+    case simd_level::none:
+      break;
+  }
+#endif
+  (void)level;
+  return detail::difference_scalar(a, na, b, nb, out);
+}
+
+/// @internal
+inline
+std::size_t
+set_difference( const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb
+              , std::uint32_t* out)
+noexcept
+{
+  return set_difference(detected_simd_level(), a, na, b, nb, out);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::util
+
+#endif // _SDD_UTIL_SET_OPERATIONS_HH_
@@ -0,0 +1,274 @@
+#ifndef _SDD_UTIL_WORK_STEALING_POOL_HH_
+#define _SDD_UTIL_WORK_STEALING_POOL_HH_
+
+#include <algorithm> // min
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception> // exception_ptr
+#include <functional>
+#include <memory>    // unique_ptr
+#include <mutex>
+#include <thread>
+#include <utility>   // pair
+#include <vector>
+
+namespace sdd { namespace util {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A pool of threads which steal tasks from each other.
+///
+/// Each worker has its own deque of tasks: it pushes and pops tasks at the back, while idle
+/// workers steal tasks at the front of the others' deques. Threads which are not workers of the
+/// pool share an additional deque.
+///
+/// A thread waiting for its tasks to complete executes pending tasks in the meantime, thus
+/// parallel_for() can be nested without exhausting the workers.
+class work_stealing_pool
+{
+  // Can't copy a work_stealing_pool.
+  work_stealing_pool(const work_stealing_pool&) = delete;
+  work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+private:
+
+  /// @brief The type of a task.
+  using task_type = std::function<void ()>;
+
+  /// @brief The tasks of a thread.
+  struct queue
+  {
+    /// @brief Protect tasks.
+    std::mutex mutex;
+
+    /// @brief The pending tasks.
+    std::deque<task_type> tasks;
+  };
+
+  /// @brief The tasks of all threads.
+  ///
+  /// The first one is shared by all threads which are not workers of this pool.
+  std::vector<std::unique_ptr<queue>> queues_;
+
+  /// @brief The workers.
+  std::vector<std::thread> threads_;
+
+  /// @brief The number of tasks stored in all queues.
+  std::atomic<std::size_t> pending_;
+
+  /// @brief Tell workers to exit.
+  bool stop_;
+
+  /// @brief Protect stop_ and put idle workers to sleep.
+  std::mutex sleep_mutex_;
+
+  /// @brief Wake up idle workers.
+  std::condition_variable sleep_cv_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param nb_threads The number of workers. With 0 workers, all tasks are executed by the
+  /// calling thread.
+  explicit work_stealing_pool(std::size_t nb_threads)
+    : queues_()
+    , threads_()
+    , pending_(0)
+    , stop_(false)
+    , sleep_mutex_()
+    , sleep_cv_()
+  {
+    for (std::size_t i = 0; i <= nb_threads; ++i)
+    {
+      queues_.emplace_back(new queue);
+    }
+    for (std::size_t i = 1; i <= nb_threads; ++i)
+    {
+      threads_.emplace_back([this, i]{work(i);});
+    }
+  }
+
+  /// @brief Destructor.
+  ///
+  /// Wait for all workers to exit.
+  ~work_stealing_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& t : threads_)
+    {
+      t.join();
+    }
+  }
+
+  /// @brief Get the number of workers.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return threads_.size();
+  }
+
+  /// @brief Apply a function to all indexes of [0, n), in parallel.
+  /// @param grain The number of consecutive indexes processed by a single task.
+  ///
+  /// Return when all indexes have been processed. If f throws, the first exception is rethrown
+  /// once all tasks are completed.
+  template <typename Function>
+  void
+  parallel_for(std::size_t n, std::size_t grain, const Function& f)
+  {
+    grain = grain == 0 ? 1 : grain;
+    const std::size_t nb_chunks = (n + grain - 1) / grain;
+    if (threads_.empty() or nb_chunks <= 1)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        f(i);
+      }
+      return;
+    }
+
+    std::atomic<std::size_t> remaining(nb_chunks - 1);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const auto chunk = [&](std::size_t c)
+    {
+      const std::size_t end = std::min(n, (c + 1) * grain);
+      try
+      {
+        for (std::size_t i = c * grain; i < end; ++i)
+        {
+          f(i);
+        }
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (not error)
+        {
+          error = std::current_exception();
+        }
+      }
+    };
+
+    // Push in reverse order: the current thread pops the first chunks while thieves take the last
+    // ones.
+    const std::size_t index = current_index();
+    {
+      queue& q = *queues_[index];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      for (std::size_t c = nb_chunks - 1; c > 0; --c)
+      {
+        q.tasks.emplace_back([&, c]{chunk(c); --remaining;});
+      }
+      pending_ += nb_chunks - 1;
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_all();
+
+    chunk(0);
+    while (remaining.load() != 0)
+    {
+      if (not run_one(index))
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+
+  /// @brief Identify the pool and the queue of the current thread.
+  static
+  std::pair<const work_stealing_pool*, std::size_t>&
+  current_worker()
+  noexcept
+  {
+    static thread_local std::pair<const work_stealing_pool*, std::size_t> w(nullptr, 0);
+    return w;
+  }
+
+  /// @brief Get the index of the current thread's queue.
+  std::size_t
+  current_index()
+  const noexcept
+  {
+    const auto& w = current_worker();
+    return w.first == this ? w.second : 0;
+  }
+
+  /// @brief Execute a pending task, if any.
+  /// @param index The queue of the current thread, tried first.
+  /// @return false if no task was found.
+  bool
+  run_one(std::size_t index)
+  {
+    task_type task;
+    for (std::size_t i = 0; i < queues_.size(); ++i)
+    {
+      queue& q = *queues_[(index + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (not q.tasks.empty())
+      {
+        if (i == 0)
+        {
+          task = std::move(q.tasks.back());
+          q.tasks.pop_back();
+        }
+        else
+        {
+          task = std::move(q.tasks.front());
+          q.tasks.pop_front();
+        }
+        --pending_;
+        break;
+      }
+    }
+    if (not task)
+    {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+  /// @brief The loop of a worker.
+  void
+  work(std::size_t index)
+  {
+    current_worker() = std::make_pair(this, index);
+    while (true)
+    {
+      if (run_one(index))
+      {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      sleep_cv_.wait(lock, [&]{return stop_ or pending_.load() != 0;});
+      if (stop_)
+      {
+        return;
+      }
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::util
+
+#endif // _SDD_UTIL_WORK_STEALING_POOL_HH_
@@ -1,18 +1,22 @@
 #ifndef _SDD_VALUES_FLAT_SET_HH_
 #define _SDD_VALUES_FLAT_SET_HH_
 
-#include <algorithm>  // copy, set_difference, set_intersection, set_union
+#include <algorithm>  // copy, min
 #include <functional> // hash
 #include <initializer_list>
 #include <iosfwd>
-#include <iterator>   // inserter
+#include <iterator>   // ostream_iterator, prev
 #include <utility>    // pair
+#include <vector>
 
 #include "sdd/values_manager_fwd.hh"
+#include "sdd/mem/concurrent_unique_table.hh"
 #include "sdd/mem/ptr.hh"
 #include "sdd/mem/ref_counted.hh"
 #include "sdd/util/boost_flat_set_no_warnings.hh"
+#include "sdd/util/concurrency.hh"
 #include "sdd/util/hash.hh"
+#include "sdd/util/set_operations.hh"
 #include "sdd/values/values_traits.hh"
 
 namespace sdd { namespace values {
@@ -286,10 +290,17 @@ struct flat_set_manager
   /// @brief The type of smart pointer to a unified flat_set.
   using ptr_type = typename flat_set<Value>::ptr_type;
 
+  /// @brief The type of the unique table, shared by all threads when the library is thread-safe.
+#if defined LIBSDD_THREAD_SAFE
+  using unique_table_type = mem::concurrent_unique_table<unique_type>;
+#else
+  using unique_table_type = mem::unique_table<unique_type>;
+#endif
+
   /// @brief Manage the handler needed by ptr when a unified data is no longer referenced.
   struct ptr_handler
   {
-    ptr_handler(mem::unique_table<unique_type>& ut)
+    ptr_handler(unique_table_type& ut)
     {
       mem::set_deletion_handler<unique_type>([&](const unique_type& u){ut.erase(u);});
     }
@@ -301,7 +312,7 @@ struct flat_set_manager
   } handler;
 
   /// @brief The set of unified flat_set.
-  mem::unique_table<unique_type> unique_table;
+  unique_table_type unique_table;
 
   /// @brief The cached empty flat_set.
   const ptr_type empty;
@@ -378,7 +389,7 @@ noexcept
 /// @brief Comparison of flat_set
 /// @related flat_set
 ///
-/// O(1). The order on flat_set is arbitrary. 
+/// O(1). The order on flat_set is arbitrary, but it's the same at each run.
 template <typename Value>
 inline
 bool
@@ -408,17 +419,52 @@ operator<<(std::ostream& os, const flat_set<Value>& fs)
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Get a buffer for the result of an operation on flat_set.
+///
+/// It's reused by all operations of a thread, thus no allocation is needed once it's large enough.
+template <typename Value>
+inline
+Value*
+operation_buffer(std::size_t size)
+{
+  static LIBSDD_THREAD_LOCAL std::vector<Value> buffer;
+  if (buffer.size() < size + util::set_operations_padding)
+  {
+    buffer.resize(size + util::set_operations_padding);
+  }
+  return buffer.data();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @related flat_set
+///
+/// The sorted arrays of both operands are given to util::set_difference, which gallops when an
+/// operand is much larger, and which is vectorized for 32 bits integers.
 template <typename Value>
 inline
 flat_set<Value>
 difference(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
 noexcept
 {
-  typename flat_set<Value>::data_type res;
-  std::set_difference( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
-                     , std::inserter(res, res.begin()));
-  return {std::move(res)};
+  if (lhs.empty() or rhs.empty())
+  {
+    return lhs;
+  }
+  if (lhs == rhs)
+  {
+    return {};
+  }
+  auto* res = operation_buffer<Value>(lhs.size());
+  const auto n = util::set_difference( &*lhs.cbegin(), lhs.size(), &*rhs.cbegin(), rhs.size()
+                                     , res);
+  if (n == lhs.size())
+  {
+    return lhs;
+  }
+  using data_type = typename flat_set<Value>::data_type;
+  return {data_type(boost::container::ordered_unique_range, res, res + n)};
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -430,10 +476,27 @@ flat_set<Value>
 intersection(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
 noexcept
 {
-  typename flat_set<Value>::data_type res;
-  std::set_intersection( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
-                       , std::inserter(res, res.begin()));
-  return {std::move(res)};
+  if (lhs.empty() or lhs == rhs)
+  {
+    return lhs;
+  }
+  if (rhs.empty())
+  {
+    return rhs;
+  }
+  auto* res = operation_buffer<Value>(std::min(lhs.size(), rhs.size()));
+  const auto n = util::set_intersection( &*lhs.cbegin(), lhs.size(), &*rhs.cbegin(), rhs.size()
+                                       , res);
+  if (n == lhs.size())
+  {
+    return lhs;
+  }
+  if (n == rhs.size())
+  {
+    return rhs;
+  }
+  using data_type = typename flat_set<Value>::data_type;
+  return {data_type(boost::container::ordered_unique_range, res, res + n)};
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -445,10 +508,26 @@ flat_set<Value>
 sum(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
 noexcept
 {
-  typename flat_set<Value>::data_type res;
-  std::set_union( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
-                , std::inserter(res, res.begin()));
-  return {std::move(res)};
+  if (rhs.empty() or lhs == rhs)
+  {
+    return lhs;
+  }
+  if (lhs.empty())
+  {
+    return rhs;
+  }
+  auto* res = operation_buffer<Value>(lhs.size() + rhs.size());
+  const auto n = util::set_union(&*lhs.cbegin(), lhs.size(), &*rhs.cbegin(), rhs.size(), res);
+  if (n == lhs.size())
+  {
+    return lhs;
+  }
+  if (n == rhs.size())
+  {
+    return rhs;
+  }
+  using data_type = typename flat_set<Value>::data_type;
+  return {data_type(boost::container::ordered_unique_range, res, res + n)};
 }
 
 /*------------------------------------------------------------------------------------------------*/
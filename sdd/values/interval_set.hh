@@ -0,0 +1,876 @@
+#ifndef _SDD_VALUES_INTERVAL_SET_HH_
+#define _SDD_VALUES_INTERVAL_SET_HH_
+
+#include <algorithm>   // max, min, sort, upper_bound
+#include <cstddef>     // ptrdiff_t
+#include <cstdint>     // uint64_t
+#include <functional>  // hash
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>    // forward_iterator_tag
+#include <type_traits> // is_unsigned
+#include <utility>     // move
+#include <vector>
+
+#include "sdd/values_manager_fwd.hh"
+#include "sdd/mem/concurrent_unique_table.hh"
+#include "sdd/mem/ptr.hh"
+#include "sdd/mem/ref_counted.hh"
+#include "sdd/util/hash.hh"
+#include "sdd/values/values_traits.hh"
+
+namespace sdd { namespace values {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief A closed interval of values [first, last].
+template <typename Value>
+struct interval
+{
+  Value first;
+  Value last;
+
+  /// @brief Get the number of values of this interval.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return static_cast<std::size_t>(last - first) + 1;
+  }
+};
+
+/// @related interval
+template <typename Value>
+inline
+bool
+operator==(const interval<Value>& lhs, const interval<Value>& rhs)
+noexcept
+{
+  return lhs.first == rhs.first and lhs.last == rhs.last;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The unified data of an interval_set.
+template <typename Value>
+struct interval_set_data
+{
+  /// @brief Sorted, disjoint and non-adjacent intervals.
+  std::vector<interval<Value>> intervals;
+
+  /// @brief The total number of values, computed once.
+  std::size_t size;
+
+  /// @brief Constructor of an empty set.
+  interval_set_data()
+    : intervals(), size(0)
+  {}
+
+  /// @brief Constructor from canonical intervals.
+  interval_set_data(std::vector<interval<Value>>&& is)
+    : intervals(std::move(is)), size(0)
+  {
+    for (const auto& i : intervals)
+    {
+      size += i.size();
+    }
+  }
+
+  bool
+  operator==(const interval_set_data& other)
+  const noexcept
+  {
+    return size == other.size and intervals == other.intervals;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Accumulate values and intervals before the construction of an interval_set.
+///
+/// They are added in any order, they are sorted and merged once by the construction of the set.
+template <typename Value>
+class interval_set_builder
+{
+private:
+
+  /// @brief The accumulated intervals, possibly overlapping.
+  std::vector<interval<Value>> intervals_;
+
+public:
+
+  /// @brief The type of an iterator on the accumulated intervals.
+  using const_iterator = typename std::vector<interval<Value>>::const_iterator;
+
+  /// @brief Add a value.
+  void
+  insert(const Value& x)
+  {
+    intervals_.push_back({x, x});
+  }
+
+  /// @brief Add a value, the hint is ignored.
+  void
+  insert(const_iterator, const Value& x)
+  {
+    intervals_.push_back({x, x});
+  }
+
+  /// @brief Add all values of [first, last].
+  void
+  insert(const Value& first, const Value& last)
+  {
+    if (first <= last)
+    {
+      intervals_.push_back({first, last});
+    }
+  }
+
+  /// @brief Reserve room for n values or intervals.
+  void
+  reserve(std::size_t n)
+  {
+    intervals_.reserve(n);
+  }
+
+  /// @brief Get the end of the accumulated intervals.
+  const_iterator
+  end()
+  const noexcept
+  {
+    return intervals_.cend();
+  }
+
+  /// @internal
+  /// @brief Get the accumulated intervals.
+  std::vector<interval<Value>>&
+  intervals()
+  noexcept
+  {
+    return intervals_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief A unified set of unsigned integers, implemented with a sorted vector of intervals.
+///
+/// The memory and the cost of operations depend on the number of ranges of contiguous values,
+/// rather than on the number of values. It's well suited to variables like counters or clocks.
+template <typename Value>
+class interval_set final
+{
+  static_assert(std::is_unsigned<Value>::value, "interval_set only stores unsigned integers.");
+
+public:
+
+  /// @brief The type of the contained value.
+  using value_type = Value;
+
+  /// @brief The type of an interval of values.
+  using interval_type = interval<Value>;
+
+  /// @internal
+  /// @brief The type of the real container.
+  using data_type = interval_set_data<Value>;
+
+  /// @internal
+  /// @brief How to hash a data_type.
+  struct hash_type
+  {
+    std::size_t
+    operator()(const data_type& d)
+    const noexcept
+    {
+      std::size_t seed = 0;
+      for (const auto& i : d.intervals)
+      {
+        sdd::util::hash_combine(seed, i.first);
+        sdd::util::hash_combine(seed, i.last);
+      }
+      return seed;
+    }
+  };
+
+  /// @internal
+  using unique_type = mem::ref_counted<data_type, hash_type>;
+
+  /// @internal
+  using ptr_type = mem::ptr<unique_type>;
+
+  /// @brief A forward iterator on the values of an interval_set, in increasing order.
+  class const_iterator
+  {
+  public:
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Value*;
+    using reference = const Value&;
+
+  private:
+
+    /// @brief The iterated intervals.
+    const std::vector<interval_type>* intervals_;
+
+    /// @brief The index of the current interval.
+    std::size_t index_;
+
+    /// @brief The current value.
+    Value value_;
+
+  public:
+
+    /// @brief Default constructor.
+    const_iterator()
+      : intervals_(nullptr), index_(0), value_(0)
+    {}
+
+    /// @internal
+    /// @brief Constructor at the first value of an interval.
+    const_iterator(const std::vector<interval_type>& intervals, std::size_t index)
+      : intervals_(&intervals), index_(index)
+      , value_(index < intervals.size() ? intervals[index].first : 0)
+    {}
+
+    reference
+    operator*()
+    const noexcept
+    {
+      return value_;
+    }
+
+    pointer
+    operator->()
+    const noexcept
+    {
+      return &value_;
+    }
+
+    const_iterator&
+    operator++()
+    noexcept
+    {
+      if (value_ == (*intervals_)[index_].last)
+      {
+        *this = const_iterator(*intervals_, index_ + 1);
+      }
+      else
+      {
+        ++value_;
+      }
+      return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    noexcept
+    {
+      const auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend
+    bool
+    operator==(const const_iterator& lhs, const const_iterator& rhs)
+    noexcept
+    {
+      return lhs.intervals_ == rhs.intervals_ and lhs.index_ == rhs.index_
+         and lhs.value_ == rhs.value_;
+    }
+
+    friend
+    bool
+    operator!=(const const_iterator& lhs, const const_iterator& rhs)
+    noexcept
+    {
+      return not (lhs == rhs);
+    }
+  };
+
+private:
+
+  /// @brief A pointer to the unified set of values.
+  ptr_type ptr_;
+
+public:
+
+  /// @brief Default copy constructor.
+  interval_set(const interval_set&) = default;
+
+  /// @brief Default copy operator.
+  interval_set& operator=(const interval_set&) = default;
+
+  /// @brief Default constructor.
+  interval_set()
+    : ptr_(empty_set())
+  {}
+
+  /// @brief Constructor with a range of values.
+  template <typename InputIterator>
+  interval_set(InputIterator begin, InputIterator end)
+    : ptr_(empty_set())
+  {
+    interval_set_builder<Value> builder;
+    for (; begin != end; ++begin)
+    {
+      builder.insert(*begin);
+    }
+    ptr_ = create(std::move(builder.intervals()));
+  }
+
+  /// @brief Constructor with a initializer_list of values.
+  interval_set(std::initializer_list<Value> values)
+    : interval_set(values.begin(), values.end())
+  {}
+
+  /// @brief Constructor from a temporary builder.
+  interval_set(interval_set_builder<Value>&& builder)
+    : ptr_(create(std::move(builder.intervals())))
+  {}
+
+  /// @internal
+  /// @brief Constructor from a temporary data_type.
+  interval_set(data_type&& d)
+    : ptr_(create(std::move(d)))
+  {}
+
+  /// @brief Insert a value.
+  /// @return true if the value was not already in this set.
+  bool
+  insert(const Value& x)
+  {
+    if (contains(x))
+    {
+      return false;
+    }
+    *this = sum(*this, interval_set {x});
+    return true;
+  }
+
+  /// @brief Erase a value.
+  std::size_t
+  erase(const Value& x)
+  {
+    if (not contains(x))
+    {
+      return 0;
+    }
+    *this = difference(*this, interval_set {x});
+    return 1;
+  }
+
+  /// @brief Tell if a value is in this set.
+  ///
+  /// O(log(#intervals)).
+  bool
+  contains(const Value& x)
+  const noexcept
+  {
+    const auto& is = intervals();
+    // The first interval which starts after x.
+    const auto search = std::upper_bound( is.cbegin(), is.cend(), x
+                                        , [](const Value& v, const interval_type& i)
+                                            {
+                                              return v < i.first;
+                                            });
+    return search != is.cbegin() and x <= std::prev(search)->last;
+  }
+
+  /// @brief Get the sorted, disjoint and non-adjacent intervals of this set.
+  const std::vector<interval_type>&
+  intervals()
+  const noexcept
+  {
+    return ptr_->data().intervals;
+  }
+
+  /// @brief Get this set with k subtracted from all its values.
+  ///
+  /// O(#intervals). All values must be greater or equal than k.
+  interval_set
+  translate_down(const Value& k)
+  const
+  {
+    return translate(k, [](Value v, Value d){return v - d;});
+  }
+
+  /// @brief Get this set with k added to all its values.
+  ///
+  /// O(#intervals). All values plus k must fit in a Value.
+  interval_set
+  translate_up(const Value& k)
+  const
+  {
+    return translate(k, [](Value v, Value d){return v + d;});
+  }
+
+  /// @brief Get the beginning of this set of values.
+  const_iterator
+  begin()
+  const noexcept
+  {
+    return const_iterator(intervals(), 0);
+  }
+
+  /// @brief Get the end of this set of values.
+  const_iterator
+  end()
+  const noexcept
+  {
+    return const_iterator(intervals(), intervals().size());
+  }
+
+  /// @brief Get the beginning of this set of values.
+  const_iterator
+  cbegin()
+  const noexcept
+  {
+    return begin();
+  }
+
+  /// @brief Get the end of this set of values.
+  const_iterator
+  cend()
+  const noexcept
+  {
+    return end();
+  }
+
+  /// @brief Tell if this set of values is empty.
+  bool
+  empty()
+  const noexcept
+  {
+    return ptr_->data().size == 0;
+  }
+
+  /// @brief Get the number of contained values.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return ptr_->data().size;
+  }
+
+  /// @internal
+  /// @brief Get the pointer to the unified data.
+  ptr_type
+  ptr()
+  const noexcept
+  {
+    return ptr_;
+  }
+
+  /// @internal
+  static
+  ptr_type
+  empty_set()
+  {
+    return global_values<interval_set<Value>>().state.empty;
+  }
+
+private:
+
+  /// @brief Apply the same translation to the bounds of all intervals.
+  ///
+  /// A translation keeps intervals sorted, disjoint and non-adjacent.
+  template <typename Translation>
+  interval_set
+  translate(const Value& k, Translation&& t)
+  const
+  {
+    if (empty() or k == 0)
+    {
+      return *this;
+    }
+    std::vector<interval_type> res;
+    res.reserve(intervals().size());
+    for (const auto& i : intervals())
+    {
+      res.push_back({t(i.first, k), t(i.last, k)});
+    }
+    return {data_type(std::move(res))};
+  }
+
+  /// @brief Create a smart pointer to a unified set of values, from unsorted intervals.
+  static
+  ptr_type
+  create(std::vector<interval_type>&& is)
+  {
+    if (is.empty())
+    {
+      return empty_set();
+    }
+    std::sort( is.begin(), is.end()
+             , [](const interval_type& lhs, const interval_type& rhs)
+                 {
+                   return lhs.first < rhs.first;
+                 });
+    // Merge overlapping and adjacent intervals in place.
+    auto res = is.begin();
+    for (auto cit = std::next(is.begin()); cit != is.end(); ++cit)
+    {
+      if (std::uint64_t(cit->first) <= std::uint64_t(res->last) + 1)
+      {
+        res->last = std::max(res->last, cit->last);
+      }
+      else
+      {
+        *++res = *cit;
+      }
+    }
+    is.erase(std::next(res), is.end());
+    is.shrink_to_fit();
+    return ptr_type(unify(data_type(std::move(is))));
+  }
+
+  /// @brief Create a smart pointer to a unified set of values, from a data_type.
+  static
+  ptr_type
+  create(data_type&& x)
+  {
+    if (x.size == 0)
+    {
+      return empty_set();
+    }
+    else
+    {
+      return ptr_type(unify(std::move(x)));
+    }
+  }
+
+  /// @brief Return the unfied version of a data_type.
+  static
+  unique_type&
+  unify(data_type&& x)
+  {
+    auto& ut = global_values<interval_set<Value>>().state.unique_table;
+    char* addr = ut.allocate(0 /*extra bytes*/);
+    unique_type* u = new (addr) unique_type(std::move(x));
+    return ut(u);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Will be used by sdd::manager.
+template <typename Value>
+struct interval_set_manager
+{
+  /// @brief The type of a unified interval_set.
+  using unique_type = typename interval_set<Value>::unique_type;
+
+  /// @brief The type of smart pointer to a unified interval_set.
+  using ptr_type = typename interval_set<Value>::ptr_type;
+
+  /// @brief The type of the unique table, shared by all threads when the library is thread-safe.
+#if defined LIBSDD_THREAD_SAFE
+  using unique_table_type = mem::concurrent_unique_table<unique_type>;
+#else
+  using unique_table_type = mem::unique_table<unique_type>;
+#endif
+
+  /// @brief Manage the handler needed by ptr when a unified data is no longer referenced.
+  struct ptr_handler
+  {
+    ptr_handler(interval_set_manager& manager)
+    {
+      mem::set_deletion_handler<unique_type>([&manager](const unique_type& u)
+                                             {manager.unique_table.erase(u);});
+    }
+
+    ~ptr_handler()
+    {
+      mem::reset_deletion_handler<unique_type>();
+    }
+  } handler;
+
+  /// @brief The set of unified interval_set.
+  unique_table_type unique_table;
+
+  /// @brief The cached empty interval_set.
+  const ptr_type empty;
+
+  /// @brief Constructor.
+  template <typename C>
+  interval_set_manager(const C& configuration)
+    : handler(*this)
+    , unique_table(configuration.interval_set_unique_table_size)
+    , empty(mk_empty())
+  {}
+
+private:
+
+  /// @brief Helper to construct the empty interval_set.
+  ptr_type
+  mk_empty()
+  {
+    char* addr = unique_table.allocate(0 /*extra bytes*/);
+    unique_type* u = new (addr) unique_type;
+    return ptr_type(unique_table(u));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @related interval_set
+///
+/// Indicate to the library that interval_set needs to store a global state.
+template <typename Value>
+struct values_traits<interval_set<Value>>
+{
+  static constexpr bool stateful = true;
+  static constexpr bool fast_iterable = true;
+  using state_type = interval_set_manager<Value>;
+  using builder = interval_set_builder<Value>;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Equality of interval_set
+/// @related interval_set
+///
+/// O(1).
+template <typename Value>
+inline
+bool
+operator==(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+noexcept
+{
+  // Pointer equality.
+  return lhs.ptr() == rhs.ptr();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Inequality of interval_set
+/// @related interval_set
+///
+/// O(1).
+template <typename Value>
+inline
+bool
+operator!=(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+noexcept
+{
+  // Pointer inequality.
+  return not(lhs.ptr() == rhs.ptr());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Comparison of interval_set
+/// @related interval_set
+///
+/// O(1). The order on interval_set is arbitrary, but it's the same at each run.
+template <typename Value>
+inline
+bool
+operator<(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+noexcept
+{
+  // Pointer comparison.
+  return lhs.ptr() < rhs.ptr();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Textual output of an interval_set
+/// @related interval_set
+///
+/// Intervals of more than one value are displayed as first..last.
+template <typename Value>
+std::ostream&
+operator<<(std::ostream& os, const interval_set<Value>& s)
+{
+  os << "{";
+  bool first = true;
+  for (const auto& i : s.intervals())
+  {
+    if (not first)
+    {
+      os << ",";
+    }
+    first = false;
+    os << i.first;
+    if (i.last != i.first)
+    {
+      os << ".." << i.last;
+    }
+  }
+  return os << "}";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related interval_set
+///
+/// O(#intervals of lhs + #intervals of rhs).
+template <typename Value>
+inline
+interval_set<Value>
+difference(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+{
+  if (lhs.empty() or rhs.empty())
+  {
+    return lhs;
+  }
+  if (lhs == rhs)
+  {
+    return {};
+  }
+  const auto& r = rhs.intervals();
+  std::vector<interval<Value>> res;
+  auto rit = r.cbegin();
+  for (const auto& i : lhs.intervals())
+  {
+    // Skip the intervals of rhs entirely before i.
+    while (rit != r.cend() and rit->last < i.first)
+    {
+      ++rit;
+    }
+    auto first = i.first;
+    bool done = false;
+    for (auto cit = rit; cit != r.cend() and cit->first <= i.last; ++cit)
+    {
+      if (first < cit->first)
+      {
+        res.push_back({first, static_cast<Value>(cit->first - 1)});
+      }
+      if (cit->last >= i.last)
+      {
+        done = true;
+        break;
+      }
+      first = static_cast<Value>(cit->last + 1);
+    }
+    if (not done)
+    {
+      res.push_back({first, i.last});
+    }
+  }
+  if (res == lhs.intervals())
+  {
+    return lhs;
+  }
+  return {interval_set_data<Value>(std::move(res))};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related interval_set
+///
+/// O(#intervals of lhs + #intervals of rhs).
+template <typename Value>
+inline
+interval_set<Value>
+intersection(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+{
+  if (lhs.empty() or lhs == rhs)
+  {
+    return lhs;
+  }
+  if (rhs.empty())
+  {
+    return rhs;
+  }
+  const auto& l = lhs.intervals();
+  const auto& r = rhs.intervals();
+  std::vector<interval<Value>> res;
+  auto lit = l.cbegin();
+  auto rit = r.cbegin();
+  while (lit != l.cend() and rit != r.cend())
+  {
+    const auto first = std::max(lit->first, rit->first);
+    const auto last = std::min(lit->last, rit->last);
+    if (first <= last)
+    {
+      res.push_back({first, last});
+    }
+    // The interval which ends first can't intersect the next ones of the other operand.
+    if (lit->last < rit->last)
+    {
+      ++lit;
+    }
+    else
+    {
+      ++rit;
+    }
+  }
+  return {interval_set_data<Value>(std::move(res))};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related interval_set
+///
+/// O(#intervals of lhs + #intervals of rhs).
+template <typename Value>
+inline
+interval_set<Value>
+sum(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+{
+  if (rhs.empty() or lhs == rhs)
+  {
+    return lhs;
+  }
+  if (lhs.empty())
+  {
+    return rhs;
+  }
+  const auto& l = lhs.intervals();
+  const auto& r = rhs.intervals();
+  std::vector<interval<Value>> res;
+  res.reserve(l.size() + r.size());
+  auto lit = l.cbegin();
+  auto rit = r.cbegin();
+  while (lit != l.cend() or rit != r.cend())
+  {
+    // Take the interval which starts first.
+    const auto& i = rit == r.cend() or (lit != l.cend() and lit->first < rit->first)
+                  ? *lit++
+                  : *rit++;
+    // Merge it with the last one if they overlap or are adjacent.
+    if (not res.empty() and std::uint64_t(i.first) <= std::uint64_t(res.back().last) + 1)
+    {
+      res.back().last = std::max(res.back().last, i.last);
+    }
+    else
+    {
+      res.push_back(i);
+    }
+  }
+  return {interval_set_data<Value>(std::move(res))};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::values
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Hash specialization for sdd::values::interval_set
+template <typename Value>
+struct hash<sdd::values::interval_set<Value>>
+{
+  std::size_t
+  operator()(const sdd::values::interval_set<Value>& s)
+  const noexcept
+  {
+    return sdd::util::hash(s.ptr());
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
+
+#endif // _SDD_VALUES_INTERVAL_SET_HH_
@@ -0,0 +1,1097 @@
+#ifndef _SDD_VALUES_ROARING_HH_
+#define _SDD_VALUES_ROARING_HH_
+
+#include <algorithm>   // binary_search, lower_bound, min, sort, unique
+#include <cstddef>     // ptrdiff_t
+#include <cstdint>     // uint16_t, uint32_t, uint64_t
+#include <functional>  // hash
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>    // forward_iterator_tag
+#include <type_traits> // is_unsigned
+#include <utility>     // move
+#include <vector>
+
+#include "sdd/values_manager_fwd.hh"
+#include "sdd/mem/concurrent_unique_table.hh"
+#include "sdd/mem/ptr.hh"
+#include "sdd/mem/ref_counted.hh"
+#include "sdd/util/hash.hh"
+#include "sdd/util/set_operations.hh"
+#include "sdd/values/values_traits.hh"
+
+namespace sdd { namespace values {
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace detail {
+
+/// @internal
+/// @brief The maximal number of values of a container stored as a sorted array.
+///
+/// Beyond, a bitmap of 2^16 bits takes less room than the array.
+constexpr std::uint32_t roaring_array_max = 4096;
+
+/// @internal
+/// @brief The number of 64 bits words of a bitmap container.
+constexpr std::size_t roaring_bitmap_words = 1024;
+
+/// @internal
+/// @brief The values of a roaring set sharing the same 16 high bits.
+///
+/// Its representation is canonical, as required by the unicity of roaring sets: it's a sorted
+/// array of the 16 low bits of its values when it has at most roaring_array_max values, a bitmap
+/// otherwise.
+struct roaring_container
+{
+  /// @brief The 16 high bits shared by all values of this container.
+  std::uint16_t key;
+
+  /// @brief The number of values of this container.
+  std::uint32_t cardinality;
+
+  /// @brief The sorted low bits of the values, when this container is an array.
+  std::vector<std::uint16_t> array;
+
+  /// @brief The bits of the values, when this container is a bitmap.
+  std::vector<std::uint64_t> bitmap;
+
+  /// @brief Constructor of an empty container.
+  explicit roaring_container(std::uint16_t k)
+    : key(k), cardinality(0), array(), bitmap()
+  {}
+
+  /// @brief Tell if this container is a bitmap.
+  bool
+  is_bitmap()
+  const noexcept
+  {
+    return not bitmap.empty();
+  }
+
+  /// @brief Tell if this container has a value with the given low bits.
+  bool
+  contains(std::uint16_t low)
+  const noexcept
+  {
+    if (is_bitmap())
+    {
+      return (bitmap[low / 64] >> (low % 64)) & 1;
+    }
+    return std::binary_search(array.cbegin(), array.cend(), low);
+  }
+};
+
+/// @internal
+inline
+bool
+operator==(const roaring_container& lhs, const roaring_container& rhs)
+noexcept
+{
+  return lhs.key == rhs.key and lhs.cardinality == rhs.cardinality and lhs.array == rhs.array
+     and lhs.bitmap == rhs.bitmap;
+}
+
+/// @internal
+/// @brief The unified data of a roaring set: its containers, sorted by key.
+struct roaring_data
+{
+  /// @brief The non-empty containers, sorted by key.
+  std::vector<roaring_container> containers;
+
+  /// @brief The total number of values, computed once.
+  std::size_t size;
+
+  /// @brief Constructor of an empty set.
+  roaring_data()
+    : containers(), size(0)
+  {}
+
+  /// @brief Constructor.
+  roaring_data(std::vector<roaring_container>&& cs)
+    : containers(std::move(cs)), size(0)
+  {
+    for (const auto& c : containers)
+    {
+      size += c.cardinality;
+    }
+  }
+};
+
+/// @internal
+inline
+bool
+operator==(const roaring_data& lhs, const roaring_data& rhs)
+noexcept
+{
+  return lhs.size == rhs.size and lhs.containers == rhs.containers;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+inline
+std::uint32_t
+popcount(std::uint64_t x)
+noexcept
+{
+  return static_cast<std::uint32_t>(__builtin_popcountll(x));
+}
+
+/// @internal
+/// @brief Combine two bitmaps word by word.
+/// @return The number of bits set in the result.
+///
+/// The loop has no dependency between words, thus the compiler vectorizes it.
+template <typename Operation>
+inline
+std::uint32_t
+combine_bitmaps( const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out
+               , Operation&& op)
+noexcept
+{
+  std::uint32_t cardinality = 0;
+  for (std::size_t i = 0; i < roaring_bitmap_words; ++i)
+  {
+    out[i] = op(a[i], b[i]);
+    cardinality += popcount(out[i]);
+  }
+  return cardinality;
+}
+
+/// @internal
+/// @brief Turn an array container into a bitmap container.
+inline
+void
+to_bitmap(roaring_container& c)
+{
+  c.bitmap.assign(roaring_bitmap_words, 0);
+  for (const auto low : c.array)
+  {
+    c.bitmap[low / 64] |= std::uint64_t(1) << (low % 64);
+  }
+  c.array = std::vector<std::uint16_t>();
+}
+
+/// @internal
+/// @brief Turn a bitmap container into an array container.
+inline
+void
+to_array(roaring_container& c)
+{
+  c.array.clear();
+  c.array.reserve(c.cardinality);
+  for (std::size_t i = 0; i < roaring_bitmap_words; ++i)
+  {
+    for (auto word = c.bitmap[i]; word != 0; word &= word - 1)
+    {
+      c.array.push_back(static_cast<std::uint16_t>(i * 64 + __builtin_ctzll(word)));
+    }
+  }
+  c.bitmap = std::vector<std::uint64_t>();
+}
+
+/// @internal
+/// @brief Restore the canonical representation of a container after an operation.
+inline
+void
+canonicalize(roaring_container& c)
+{
+  if (c.is_bitmap() and c.cardinality <= roaring_array_max)
+  {
+    to_array(c);
+  }
+  else if (not c.is_bitmap() and c.cardinality > roaring_array_max)
+  {
+    to_bitmap(c);
+  }
+  else if (not c.is_bitmap())
+  {
+    c.array.shrink_to_fit();
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+inline
+roaring_container
+container_union(const roaring_container& a, const roaring_container& b)
+{
+  roaring_container res(a.key);
+  if (a.is_bitmap() and b.is_bitmap())
+  {
+    res.bitmap.resize(roaring_bitmap_words);
+    res.cardinality = combine_bitmaps( a.bitmap.data(), b.bitmap.data(), res.bitmap.data()
+                                     , [](std::uint64_t x, std::uint64_t y){return x | y;});
+  }
+  else if (a.is_bitmap() or b.is_bitmap())
+  {
+    const auto& bm = a.is_bitmap() ? a : b;
+    const auto& arr = a.is_bitmap() ? b : a;
+    res.bitmap = bm.bitmap;
+    res.cardinality = bm.cardinality;
+    for (const auto low : arr.array)
+    {
+      const auto bit = std::uint64_t(1) << (low % 64);
+      res.cardinality += (res.bitmap[low / 64] & bit) == 0;
+      res.bitmap[low / 64] |= bit;
+    }
+  }
+  else
+  {
+    res.array.resize(a.cardinality + b.cardinality);
+    res.cardinality = static_cast<std::uint32_t>(
+      util::set_union( a.array.data(), a.cardinality, b.array.data(), b.cardinality
+                     , res.array.data()));
+    res.array.resize(res.cardinality);
+  }
+  canonicalize(res);
+  return res;
+}
+
+/// @internal
+/// @return An empty container when both operands have no common values.
+inline
+roaring_container
+container_intersection(const roaring_container& a, const roaring_container& b)
+{
+  roaring_container res(a.key);
+  if (a.is_bitmap() and b.is_bitmap())
+  {
+    res.bitmap.resize(roaring_bitmap_words);
+    res.cardinality = combine_bitmaps( a.bitmap.data(), b.bitmap.data(), res.bitmap.data()
+                                     , [](std::uint64_t x, std::uint64_t y){return x & y;});
+  }
+  else if (a.is_bitmap() or b.is_bitmap())
+  {
+    const auto& bm = a.is_bitmap() ? a : b;
+    const auto& arr = a.is_bitmap() ? b : a;
+    for (const auto low : arr.array)
+    {
+      if (bm.contains(low))
+      {
+        res.array.push_back(low);
+      }
+    }
+    res.cardinality = static_cast<std::uint32_t>(res.array.size());
+  }
+  else
+  {
+    res.array.resize(std::min(a.cardinality, b.cardinality));
+    res.cardinality = static_cast<std::uint32_t>(
+      util::set_intersection( a.array.data(), a.cardinality, b.array.data(), b.cardinality
+                            , res.array.data()));
+    res.array.resize(res.cardinality);
+  }
+  canonicalize(res);
+  return res;
+}
+
+/// @internal
+/// @return An empty container when all values of a are in b.
+inline
+roaring_container
+container_difference(const roaring_container& a, const roaring_container& b)
+{
+  roaring_container res(a.key);
+  if (a.is_bitmap() and b.is_bitmap())
+  {
+    res.bitmap.resize(roaring_bitmap_words);
+    res.cardinality = combine_bitmaps( a.bitmap.data(), b.bitmap.data(), res.bitmap.data()
+                                     , [](std::uint64_t x, std::uint64_t y){return x & ~y;});
+  }
+  else if (a.is_bitmap())
+  {
+    res.bitmap = a.bitmap;
+    res.cardinality = a.cardinality;
+    for (const auto low : b.array)
+    {
+      const auto bit = std::uint64_t(1) << (low % 64);
+      res.cardinality -= (res.bitmap[low / 64] & bit) != 0;
+      res.bitmap[low / 64] &= ~bit;
+    }
+  }
+  else if (b.is_bitmap())
+  {
+    for (const auto low : a.array)
+    {
+      if (not b.contains(low))
+      {
+        res.array.push_back(low);
+      }
+    }
+    res.cardinality = static_cast<std::uint32_t>(res.array.size());
+  }
+  else
+  {
+    res.array.resize(a.cardinality);
+    res.cardinality = static_cast<std::uint32_t>(
+      util::set_difference( a.array.data(), a.cardinality, b.array.data(), b.cardinality
+                          , res.array.data()));
+    res.array.resize(res.cardinality);
+  }
+  canonicalize(res);
+  return res;
+}
+
+} // namespace detail
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Accumulate values before the construction of a roaring set.
+///
+/// Values are appended in any order, they are sorted once by the construction of the set.
+template <typename Value>
+class roaring_builder
+{
+private:
+
+  /// @brief The accumulated values, possibly with duplicates.
+  std::vector<Value> values_;
+
+public:
+
+  /// @brief The type of an iterator on the accumulated values.
+  using const_iterator = typename std::vector<Value>::const_iterator;
+
+  /// @brief Add a value.
+  void
+  insert(const Value& x)
+  {
+    values_.push_back(x);
+  }
+
+  /// @brief Add a value, the hint is ignored.
+  void
+  insert(const_iterator, const Value& x)
+  {
+    values_.push_back(x);
+  }
+
+  /// @brief Reserve room for n values.
+  void
+  reserve(std::size_t n)
+  {
+    values_.reserve(n);
+  }
+
+  /// @brief Get the end of the accumulated values.
+  const_iterator
+  end()
+  const noexcept
+  {
+    return values_.cend();
+  }
+
+  /// @internal
+  /// @brief Get the accumulated values.
+  std::vector<Value>&
+  values()
+  noexcept
+  {
+    return values_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief A unified set of unsigned integers, implemented with compressed bitmaps.
+///
+/// Values are split in containers of 2^16 values sharing the same 16 high bits. A container is a
+/// sorted array of 16 bits integers when it's sparse, a bitmap when it's dense. Thus, dense sets
+/// of values take 1 bit per possible value, and operations on dense containers combine 64 values
+/// at once. It's well suited to variables with large and dense domains.
+template <typename Value>
+class roaring final
+{
+  static_assert( std::is_unsigned<Value>::value and sizeof(Value) <= 4
+               , "roaring only stores unsigned integers of at most 32 bits.");
+
+public:
+
+  /// @brief The type of the contained value.
+  using value_type = Value;
+
+  /// @internal
+  /// @brief The type of the real container.
+  using data_type = detail::roaring_data;
+
+  /// @internal
+  /// @brief How to hash a data_type.
+  struct hash_type
+  {
+    std::size_t
+    operator()(const data_type& d)
+    const noexcept
+    {
+      std::size_t seed = 0;
+      for (const auto& c : d.containers)
+      {
+        sdd::util::hash_combine(seed, c.key);
+        sdd::util::hash_combine(seed, c.cardinality);
+        sdd::util::hash_combine(seed, c.array.cbegin(), c.array.cend());
+        sdd::util::hash_combine(seed, c.bitmap.cbegin(), c.bitmap.cend());
+      }
+      return seed;
+    }
+  };
+
+  /// @internal
+  using unique_type = mem::ref_counted<data_type, hash_type>;
+
+  /// @internal
+  using ptr_type = mem::ptr<unique_type>;
+
+  /// @brief A forward iterator on the values of a roaring set, in increasing order.
+  class const_iterator
+  {
+  public:
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Value*;
+    using reference = const Value&;
+
+  private:
+
+    /// @brief The iterated data.
+    const data_type* data_;
+
+    /// @brief The index of the current container.
+    std::size_t container_;
+
+    /// @brief The index in the current array, or the current bit in the current bitmap.
+    std::uint32_t position_;
+
+    /// @brief The current value.
+    Value value_;
+
+  public:
+
+    /// @brief Default constructor.
+    const_iterator()
+      : data_(nullptr), container_(0), position_(0), value_(0)
+    {}
+
+    /// @internal
+    /// @brief Constructor at the first value of a container.
+    const_iterator(const data_type& d, std::size_t container)
+      : data_(&d), container_(container), position_(0), value_(0)
+    {
+      if (container_ < data_->containers.size())
+      {
+        const auto& c = data_->containers[container_];
+        if (c.is_bitmap())
+        {
+          position_ = next_bit(c, 0);
+        }
+        update();
+      }
+    }
+
+    reference
+    operator*()
+    const noexcept
+    {
+      return value_;
+    }
+
+    pointer
+    operator->()
+    const noexcept
+    {
+      return &value_;
+    }
+
+    const_iterator&
+    operator++()
+    noexcept
+    {
+      const auto& c = data_->containers[container_];
+      if (c.is_bitmap())
+      {
+        position_ = next_bit(c, position_ + 1);
+        if (position_ < 65536)
+        {
+          update();
+          return *this;
+        }
+      }
+      else if (++position_ < c.cardinality)
+      {
+        update();
+        return *this;
+      }
+      *this = const_iterator(*data_, container_ + 1);
+      return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    noexcept
+    {
+      const auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend
+    bool
+    operator==(const const_iterator& lhs, const const_iterator& rhs)
+    noexcept
+    {
+      return lhs.data_ == rhs.data_ and lhs.container_ == rhs.container_
+         and lhs.position_ == rhs.position_;
+    }
+
+    friend
+    bool
+    operator!=(const const_iterator& lhs, const const_iterator& rhs)
+    noexcept
+    {
+      return not (lhs == rhs);
+    }
+
+  private:
+
+    /// @brief Get the first bit set from a given one, or 65536 if there is none.
+    static
+    std::uint32_t
+    next_bit(const detail::roaring_container& c, std::uint32_t from)
+    noexcept
+    {
+      std::size_t i = from / 64;
+      if (i >= detail::roaring_bitmap_words)
+      {
+        return 65536;
+      }
+      auto word = c.bitmap[i] & (~std::uint64_t(0) << (from % 64));
+      while (word == 0)
+      {
+        if (++i == detail::roaring_bitmap_words)
+        {
+          return 65536;
+        }
+        word = c.bitmap[i];
+      }
+      return static_cast<std::uint32_t>(i * 64 + __builtin_ctzll(word));
+    }
+
+    /// @brief Compute the value at the current position.
+    void
+    update()
+    noexcept
+    {
+      const auto& c = data_->containers[container_];
+      const auto low = c.is_bitmap() ? position_ : c.array[position_];
+      value_ = static_cast<Value>((static_cast<std::uint32_t>(c.key) << 16) | low);
+    }
+  };
+
+private:
+
+  /// @brief A pointer to the unified set of values.
+  ptr_type ptr_;
+
+public:
+
+  /// @brief Default copy constructor.
+  roaring(const roaring&) = default;
+
+  /// @brief Default copy operator.
+  roaring& operator=(const roaring&) = default;
+
+  /// @brief Default constructor.
+  roaring()
+    : ptr_(empty_set())
+  {}
+
+  /// @brief Constructor with a range.
+  template <typename InputIterator>
+  roaring(InputIterator begin, InputIterator end)
+    : ptr_(create(std::vector<Value>(begin, end)))
+  {}
+
+  /// @brief Constructor with a initializer_list.
+  roaring(std::initializer_list<Value> values)
+    : roaring(values.begin(), values.end())
+  {}
+
+  /// @brief Constructor from a temporary builder.
+  roaring(roaring_builder<Value>&& builder)
+    : ptr_(create(std::move(builder.values())))
+  {}
+
+  /// @internal
+  /// @brief Constructor from a temporary data_type.
+  roaring(data_type&& d)
+    : ptr_(create(std::move(d)))
+  {}
+
+  /// @brief Insert a value.
+  /// @return true if the value was not already in this set.
+  bool
+  insert(const Value& x)
+  {
+    if (contains(x))
+    {
+      return false;
+    }
+    *this = sum(*this, roaring {x});
+    return true;
+  }
+
+  /// @brief Erase a value.
+  std::size_t
+  erase(const Value& x)
+  {
+    if (not contains(x))
+    {
+      return 0;
+    }
+    *this = difference(*this, roaring {x});
+    return 1;
+  }
+
+  /// @brief Tell if a value is in this set.
+  bool
+  contains(const Value& x)
+  const noexcept
+  {
+    const auto& cs = ptr_->data().containers;
+    const auto key = static_cast<std::uint16_t>(x >> 16);
+    const auto search = std::lower_bound( cs.cbegin(), cs.cend(), key
+                                        , [](const detail::roaring_container& c, std::uint16_t k)
+                                            {
+                                              return c.key < k;
+                                            });
+    return search != cs.cend() and search->key == key
+       and search->contains(static_cast<std::uint16_t>(x & 0xFFFF));
+  }
+
+  /// @brief Get the beginning of this set of values.
+  const_iterator
+  begin()
+  const noexcept
+  {
+    return const_iterator(ptr_->data(), 0);
+  }
+
+  /// @brief Get the end of this set of values.
+  const_iterator
+  end()
+  const noexcept
+  {
+    return const_iterator(ptr_->data(), ptr_->data().containers.size());
+  }
+
+  /// @brief Get the beginning of this set of values.
+  const_iterator
+  cbegin()
+  const noexcept
+  {
+    return begin();
+  }
+
+  /// @brief Get the end of this set of values.
+  const_iterator
+  cend()
+  const noexcept
+  {
+    return end();
+  }
+
+  /// @brief Tell if this set of values is empty.
+  bool
+  empty()
+  const noexcept
+  {
+    return ptr_->data().size == 0;
+  }
+
+  /// @brief Get the number of contained values.
+  ///
+  /// O(1), the cardinality of bitmaps is computed with popcount when they are built.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return ptr_->data().size;
+  }
+
+  /// @internal
+  /// @brief Get the pointer to the unified data.
+  ptr_type
+  ptr()
+  const noexcept
+  {
+    return ptr_;
+  }
+
+  /// @internal
+  static
+  ptr_type
+  empty_set()
+  {
+    return global_values<roaring<Value>>().state.empty;
+  }
+
+private:
+
+  /// @brief Create a smart pointer to a unified set of values, from unsorted values.
+  static
+  ptr_type
+  create(std::vector<Value>&& values)
+  {
+    if (values.empty())
+    {
+      return empty_set();
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    std::vector<detail::roaring_container> containers;
+    for (auto cit = values.cbegin(); cit != values.cend();)
+    {
+      const auto key = static_cast<std::uint16_t>(*cit >> 16);
+      containers.emplace_back(key);
+      auto& c = containers.back();
+      for (; cit != values.cend() and (*cit >> 16) == key; ++cit)
+      {
+        c.array.push_back(static_cast<std::uint16_t>(*cit & 0xFFFF));
+      }
+      c.cardinality = static_cast<std::uint32_t>(c.array.size());
+      detail::canonicalize(c);
+    }
+    return ptr_type(unify(data_type(std::move(containers))));
+  }
+
+  /// @brief Create a smart pointer to a unified set of values, from a data_type.
+  static
+  ptr_type
+  create(data_type&& x)
+  {
+    if (x.size == 0)
+    {
+      return empty_set();
+    }
+    else
+    {
+      return ptr_type(unify(std::move(x)));
+    }
+  }
+
+  /// @brief Return the unfied version of a data_type.
+  static
+  unique_type&
+  unify(data_type&& x)
+  {
+    auto& ut = global_values<roaring<Value>>().state.unique_table;
+    char* addr = ut.allocate(0 /*extra bytes*/);
+    unique_type* u = new (addr) unique_type(std::move(x));
+    return ut(u);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Will be used by sdd::manager.
+template <typename Value>
+struct roaring_manager
+{
+  /// @brief The type of a unified roaring.
+  using unique_type = typename roaring<Value>::unique_type;
+
+  /// @brief The type of smart pointer to a unified roaring.
+  using ptr_type = typename roaring<Value>::ptr_type;
+
+  /// @brief The type of the unique table, shared by all threads when the library is thread-safe.
+#if defined LIBSDD_THREAD_SAFE
+  using unique_table_type = mem::concurrent_unique_table<unique_type>;
+#else
+  using unique_table_type = mem::unique_table<unique_type>;
+#endif
+
+  /// @brief Manage the handler needed by ptr when a unified data is no longer referenced.
+  struct ptr_handler
+  {
+    ptr_handler(roaring_manager& manager)
+    {
+      mem::set_deletion_handler<unique_type>([&manager](const unique_type& u)
+                                             {manager.unique_table.erase(u);});
+    }
+
+    ~ptr_handler()
+    {
+      mem::reset_deletion_handler<unique_type>();
+    }
+  } handler;
+
+  /// @brief The set of unified roaring.
+  unique_table_type unique_table;
+
+  /// @brief The cached empty roaring.
+  const ptr_type empty;
+
+  /// @brief Constructor.
+  template <typename C>
+  roaring_manager(const C& configuration)
+    : handler(*this)
+    , unique_table(configuration.roaring_unique_table_size)
+    , empty(mk_empty())
+  {}
+
+private:
+
+  /// @brief Helper to construct the empty roaring.
+  ptr_type
+  mk_empty()
+  {
+    char* addr = unique_table.allocate(0 /*extra bytes*/);
+    unique_type* u = new (addr) unique_type;
+    return ptr_type(unique_table(u));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @related roaring
+///
+/// Indicate to the library that roaring needs to store a global state.
+template <typename Value>
+struct values_traits<roaring<Value>>
+{
+  static constexpr bool stateful = true;
+  static constexpr bool fast_iterable = true;
+  using state_type = roaring_manager<Value>;
+  using builder = roaring_builder<Value>;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Equality of roaring
+/// @related roaring
+///
+/// O(1).
+template <typename Value>
+inline
+bool
+operator==(const roaring<Value>& lhs, const roaring<Value>& rhs)
+noexcept
+{
+  // Pointer equality.
+  return lhs.ptr() == rhs.ptr();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Inequality of roaring
+/// @related roaring
+///
+/// O(1).
+template <typename Value>
+inline
+bool
+operator!=(const roaring<Value>& lhs, const roaring<Value>& rhs)
+noexcept
+{
+  // Pointer inequality.
+  return not(lhs.ptr() == rhs.ptr());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Comparison of roaring
+/// @related roaring
+///
+/// O(1). The order on roaring is arbitrary, but it's the same at each run.
+template <typename Value>
+inline
+bool
+operator<(const roaring<Value>& lhs, const roaring<Value>& rhs)
+noexcept
+{
+  // Pointer comparison.
+  return lhs.ptr() < rhs.ptr();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Textual output of a roaring
+/// @related roaring
+template <typename Value>
+std::ostream&
+operator<<(std::ostream& os, const roaring<Value>& r)
+{
+  os << "{";
+  bool first = true;
+  for (const auto v : r)
+  {
+    if (not first)
+    {
+      os << ",";
+    }
+    first = false;
+    os << v;
+  }
+  return os << "}";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related roaring
+///
+/// Containers with the same key are subtracted, the other containers of lhs are kept as is.
+template <typename Value>
+inline
+roaring<Value>
+difference(const roaring<Value>& lhs, const roaring<Value>& rhs)
+{
+  if (lhs.empty() or rhs.empty())
+  {
+    return lhs;
+  }
+  if (lhs == rhs)
+  {
+    return {};
+  }
+  const auto& l = lhs.ptr()->data().containers;
+  const auto& r = rhs.ptr()->data().containers;
+  std::vector<detail::roaring_container> res;
+  res.reserve(l.size());
+  auto rit = r.cbegin();
+  for (const auto& c : l)
+  {
+    while (rit != r.cend() and rit->key < c.key)
+    {
+      ++rit;
+    }
+    if (rit != r.cend() and rit->key == c.key)
+    {
+      auto tmp = detail::container_difference(c, *rit);
+      if (tmp.cardinality != 0)
+      {
+        res.emplace_back(std::move(tmp));
+      }
+    }
+    else
+    {
+      res.push_back(c);
+    }
+  }
+  return {detail::roaring_data(std::move(res))};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related roaring
+template <typename Value>
+inline
+roaring<Value>
+intersection(const roaring<Value>& lhs, const roaring<Value>& rhs)
+{
+  if (lhs.empty() or lhs == rhs)
+  {
+    return lhs;
+  }
+  if (rhs.empty())
+  {
+    return rhs;
+  }
+  const auto& l = lhs.ptr()->data().containers;
+  const auto& r = rhs.ptr()->data().containers;
+  std::vector<detail::roaring_container> res;
+  auto lit = l.cbegin();
+  auto rit = r.cbegin();
+  while (lit != l.cend() and rit != r.cend())
+  {
+    if (lit->key < rit->key)
+    {
+      ++lit;
+    }
+    else if (rit->key < lit->key)
+    {
+      ++rit;
+    }
+    else
+    {
+      auto tmp = detail::container_intersection(*lit++, *rit++);
+      if (tmp.cardinality != 0)
+      {
+        res.emplace_back(std::move(tmp));
+      }
+    }
+  }
+  return {detail::roaring_data(std::move(res))};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related roaring
+template <typename Value>
+inline
+roaring<Value>
+sum(const roaring<Value>& lhs, const roaring<Value>& rhs)
+{
+  if (rhs.empty() or lhs == rhs)
+  {
+    return lhs;
+  }
+  if (lhs.empty())
+  {
+    return rhs;
+  }
+  const auto& l = lhs.ptr()->data().containers;
+  const auto& r = rhs.ptr()->data().containers;
+  std::vector<detail::roaring_container> res;
+  res.reserve(l.size() + r.size());
+  auto lit = l.cbegin();
+  auto rit = r.cbegin();
+  while (lit != l.cend() and rit != r.cend())
+  {
+    if (lit->key < rit->key)
+    {
+      res.push_back(*lit++);
+    }
+    else if (rit->key < lit->key)
+    {
+      res.push_back(*rit++);
+    }
+    else
+    {
+      res.emplace_back(detail::container_union(*lit++, *rit++));
+    }
+  }
+  res.insert(res.end(), lit, l.cend());
+  res.insert(res.end(), rit, r.cend());
+  return {detail::roaring_data(std::move(res))};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::values
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Hash specialization for sdd::values::roaring
+template <typename Value>
+struct hash<sdd::values::roaring<Value>>
+{
+  std::size_t
+  operator()(const sdd::values::roaring<Value>& r)
+  const noexcept
+  {
+    return sdd::util::hash(r.ptr());
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
+
+#endif // _SDD_VALUES_ROARING_HH_
@@ -22,6 +22,7 @@ noexcept
   c.sdd_sum_cache_size = 1000;
   c.hom_unique_table_size = 1000;
   c.hom_cache_size = 1000;
+  c.proto_arcs_cache_size = 1000;
   return c;
 }
 
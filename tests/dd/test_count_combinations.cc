@@ -29,7 +29,37 @@ struct count_combinations_test
 
 /*------------------------------------------------------------------------------------------------*/
 
+template <typename C>
+struct count_combinations_cache_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  static
+  C
+  conf()
+  {
+    auto c = small_conf<C>();
+    c.combinations_cache = true;
+    return c;
+  }
+
+  count_combinations_cache_test()
+    : m(sdd::manager<C>::init(conf()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST_CASE(count_combinations_test, configurations);
+TYPED_TEST_CASE(count_combinations_cache_test, configurations);
 #include "tests/macros.hh"
 
 /*------------------------------------------------------------------------------------------------*/
@@ -57,6 +87,79 @@ TYPED_TEST(count_combinations_test, flat)
 
 /*------------------------------------------------------------------------------------------------*/
 
+TYPED_TEST(count_combinations_test, large)
+{
+  using boost::multiprecision::cpp_int;
+  SDD x = one;
+  for (unsigned int i = 0; i < 63; ++i)
+  {
+    x = SDD(i, {0, 1}, x);
+  }
+  ASSERT_EQ(cpp_int(1) << 63, sdd::dd::count_combinations(x));
+
+  // Doesn't fit in 64 bits.
+  x = SDD(63, {0, 1}, x);
+  ASSERT_EQ(cpp_int(1) << 64, sdd::dd::count_combinations(x));
+  const SDD y = SDD(64, {0, 1, 2}, x);
+  ASSERT_EQ(cpp_int(3) << 64, sdd::dd::count_combinations(y));
+
+  // Beyond 128 bits.
+  SDD z = one;
+  for (unsigned int i = 0; i < 64; ++i)
+  {
+    z = SDD(i, {0, 1, 2, 3}, z);
+  }
+  ASSERT_EQ(cpp_int(1) << 128, sdd::dd::count_combinations(z));
+  ASSERT_EQ(cpp_int(1) << 130, sdd::dd::count_combinations(SDD(64, {0, 1, 2, 3}, z)));
+  ASSERT_EQ( (cpp_int(1) << 128) + (cpp_int(1) << 64)
+           , sdd::dd::count_combinations(SDD(64, {0}, z) + SDD(64, {1}, x)));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(count_combinations_cache_test, persistent)
+{
+  const auto& cache = sdd::global<conf>().combinations_cache;
+  ASSERT_EQ(0u, cache.size());
+  {
+    const SDD x = SDD(2, {0, 1}, SDD(1, {0, 1, 2}, SDD(0, {0}, one)));
+    ASSERT_EQ(6u, x.size());
+    ASSERT_EQ(3u, cache.size());
+
+    // Already counted.
+    ASSERT_EQ(6u, x.size());
+    ASSERT_EQ(3u, cache.size());
+
+    // Only the new nodes are counted.
+    const SDD y = SDD(3, {0, 1, 2, 3}, x);
+    ASSERT_EQ(24u, y.size());
+    ASSERT_EQ(4u, cache.size());
+    const SDD z = y + SDD(3, {4}, x);
+    ASSERT_EQ(30u, z.size());
+    ASSERT_EQ(5u, cache.size());
+  }
+  // Entries are erased with their nodes, once caches of operations no longer reference them.
+  this->m.gc();
+  ASSERT_EQ(0u, cache.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(count_combinations_cache_test, large)
+{
+  using boost::multiprecision::cpp_int;
+  SDD x = one;
+  for (unsigned int i = 0; i < 65; ++i)
+  {
+    x = SDD(i, {0, 1}, x);
+  }
+  ASSERT_EQ(cpp_int(1) << 65, x.size());
+  ASSERT_EQ(cpp_int(1) << 65, x.size());
+  ASSERT_EQ(cpp_int(1) << 66, SDD(65, {0, 1}, x).size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 //TYPED_TEST(count_combinations_test, hierarchical)
 //{
 //  ASSERT_EQ(3, sdd::dd::count_combinations(SDD('a', SDD('b', {0,1,2}, one), one)));
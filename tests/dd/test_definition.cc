@@ -1,4 +1,5 @@
 #include <sstream>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -124,3 +125,25 @@ TYPED_TEST(definition_test, check_compatibility)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(definition_test, content_hash)
+{
+  const auto build = [&]{return SDD(1, {0, 1}, SDD(0, {2}, one));};
+  std::size_t hash = 0;
+  {
+    const SDD x = build();
+    hash = std::hash<SDD>()(x);
+  }
+
+  // The same SDD, unified again at a different address, has the same hash.
+  std::vector<SDD> others;
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    others.push_back(SDD(0, {i + 10}, one));
+  }
+  const SDD x = build();
+  ASSERT_EQ(hash, std::hash<SDD>()(x));
+  ASSERT_EQ(hash, std::hash<SDD>()(build()));
+}
+
+/*------------------------------------------------------------------------------------------------*/
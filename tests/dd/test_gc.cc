@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+C
+gc_conf()
+noexcept
+{
+  C c = small_conf<C>();
+  c.gc_threshold = 1000000;
+  return c;
+}
+
+template <typename C>
+struct gc_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+  sdd::dd::context<C>& cxt;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  gc_test()
+    : m(sdd::manager<C>::init(gc_conf<C>()))
+    , cxt(sdd::global<C>().sdd_context)
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(gc_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(gc_test, resurrection)
+{
+  const auto build = [&]
+                       {
+                         SDD x = one;
+                         for (unsigned int i = 0; i < 10; ++i)
+                         {
+                           x = sum(cxt, {SDD(i, {0}, x), SDD(i, {1}, x)});
+                         }
+                         return x;
+                       };
+
+  const std::size_t initial_size = this->m.sdd_stats().size;
+  SDD x = build();
+  const std::size_t size = this->m.sdd_stats().size;
+  ASSERT_LT(initial_size, size);
+
+  // Unreferenced SDD are kept in the unique table.
+  x = zero;
+  cxt.clear();
+  ASSERT_EQ(size, this->m.sdd_stats().size);
+  ASSERT_LT(0u, this->m.sdd_stats().dead);
+
+  // They are reused when they are built again.
+  const std::size_t resurrections = this->m.sdd_stats().resurrections;
+  x = build();
+  ASSERT_LT(resurrections, this->m.sdd_stats().resurrections);
+  ASSERT_EQ(size, this->m.sdd_stats().size);
+
+  // Only referenced SDD are kept by a collection.
+  const SDD y = x;
+  x = zero;
+  this->m.gc();
+  ASSERT_EQ(0u, this->m.sdd_stats().dead);
+  ASSERT_GE(size, this->m.sdd_stats().size);
+  ASSERT_EQ(y, build());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(gc_test, collection)
+{
+  const std::size_t initial_size = this->m.sdd_stats().size;
+  {
+    SDD x = one;
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      x = sum(cxt, {SDD(i, {0}, x), SDD(i, {1}, x)});
+    }
+  }
+  ASSERT_LT(initial_size, this->m.sdd_stats().size);
+  this->m.gc();
+  ASSERT_EQ(initial_size, this->m.sdd_stats().size);
+  ASSERT_EQ(0u, this->m.sdd_stats().dead);
+  ASSERT_LT(0u, this->m.sdd_stats().sweeps);
+}
+
+/*------------------------------------------------------------------------------------------------*/
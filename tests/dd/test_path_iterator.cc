@@ -0,0 +1,169 @@
+#include <algorithm> // sort
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/dd/path_iterator.hh"
+#include "sdd/manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct path_iterator_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+  sdd::dd::context<C>& cxt;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  path_iterator_test()
+    : m(sdd::manager<C>::init(small_conf<C>()))
+    , cxt(sdd::global<C>().sdd_context)
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(path_iterator_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(path_iterator_test, terminals)
+{
+  {
+    sdd::path_iterator<conf> it(zero);
+    ASSERT_TRUE(it.done());
+  }
+  {
+    sdd::path_iterator<conf> it(one);
+    ASSERT_FALSE(it.done());
+    ASSERT_TRUE(it->empty());
+    ++it;
+    ASSERT_TRUE(it.done());
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(path_iterator_test, flat)
+{
+  const SDD x = sum(cxt, { SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one)))
+                         , SDD(2, {1}, SDD(1, {1}, SDD(0, {0}, one)))
+                         , SDD(2, {2}, SDD(1, {2}, SDD(0, {2}, one)))});
+  std::vector<sdd::path<conf>> v;
+  for (sdd::path_iterator<conf> it(x); not it.done(); ++it)
+  {
+    v.push_back(*it);
+  }
+  std::sort(v.begin(), v.end());
+
+  std::vector<sdd::path<conf>> r { sdd::path<conf>{{0}, {0}, {0}}
+                                 , sdd::path<conf>{{1}, {1}, {0}}
+                                 , sdd::path<conf>{{2}, {2}, {2}}
+                                 };
+  std::sort(r.begin(), r.end());
+  ASSERT_EQ(r, v);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(path_iterator_test, shared_successors)
+{
+  const SDD y = sum(cxt, {SDD(1, {0}, SDD(0, {0}, one)), SDD(1, {1}, SDD(0, {1}, one))});
+  const SDD x = sum(cxt, {SDD(2, {0}, y), SDD(2, {1}, SDD(1, {2}, SDD(0, {2}, one)))});
+  std::vector<sdd::path<conf>> v;
+  for (sdd::path_iterator<conf> it(x); not it.done(); ++it)
+  {
+    v.push_back(*it);
+  }
+  std::sort(v.begin(), v.end());
+
+  std::vector<sdd::path<conf>> r { sdd::path<conf>{{0}, {0}, {0}}
+                                 , sdd::path<conf>{{0}, {1}, {1}}
+                                 , sdd::path<conf>{{1}, {2}, {2}}
+                                 };
+  std::sort(r.begin(), r.end());
+  ASSERT_EQ(r, v);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(path_iterator_test, batches)
+{
+  const SDD x = sum(cxt, { SDD(1, {0}, SDD(0, {0}, one)), SDD(1, {1}, SDD(0, {1}, one))
+                         , SDD(1, {2}, SDD(0, {2}, one)), SDD(1, {3}, SDD(0, {3}, one))
+                         , SDD(1, {4}, SDD(0, {4}, one))});
+  std::vector<sdd::path<conf>> all;
+  for (sdd::path_iterator<conf> it(x); not it.done(); ++it)
+  {
+    all.push_back(*it);
+  }
+  ASSERT_EQ(5u, all.size());
+
+  sdd::path_iterator<conf> it(x);
+  std::vector<sdd::path<conf>> batch(2);
+  ASSERT_EQ(2u, it.next(batch.data(), batch.size()));
+  ASSERT_EQ(all[0], batch[0]);
+  ASSERT_EQ(all[1], batch[1]);
+  ASSERT_EQ(2u, it.next(batch.data(), batch.size()));
+  ASSERT_EQ(all[2], batch[0]);
+  ASSERT_EQ(all[3], batch[1]);
+  ASSERT_EQ(1u, it.next(batch.data(), batch.size()));
+  ASSERT_EQ(all[4], batch[0]);
+  ASSERT_TRUE(it.done());
+  ASSERT_EQ(0u, it.next(batch.data(), batch.size()));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(path_iterator_test, skip)
+{
+  const SDD y = sum(cxt, {SDD(1, {0}, SDD(0, {0}, one)), SDD(1, {1}, SDD(0, {1}, one))});
+  const SDD x = sum(cxt, { SDD(2, {0}, y), SDD(2, {1}, SDD(1, {2}, SDD(0, {2}, one)))
+                         , SDD(2, {2}, SDD(1, {3}, SDD(0, {3, 4}, one)))});
+  std::vector<sdd::path<conf>> all;
+  for (sdd::path_iterator<conf> it(x); not it.done(); ++it)
+  {
+    all.push_back(*it);
+  }
+  ASSERT_EQ(4u, all.size());
+
+  for (unsigned int i = 0; i < all.size(); ++i)
+  {
+    sdd::path_iterator<conf> it(x);
+    it.skip(i);
+    ASSERT_FALSE(it.done());
+    ASSERT_EQ(i, it.index());
+    ASSERT_EQ(all[i], *it);
+    // Enumeration goes on after a skip.
+    for (unsigned int j = i + 1; j < all.size(); ++j)
+    {
+      ++it;
+      ASSERT_EQ(all[j], *it);
+    }
+    ++it;
+    ASSERT_TRUE(it.done());
+  }
+
+  sdd::path_iterator<conf> it(x);
+  it.skip(1);
+  it.skip(2);
+  ASSERT_EQ(all[3], *it);
+  it.seek(0);
+  ASSERT_EQ(all[0], *it);
+  it.skip(4);
+  ASSERT_TRUE(it.done());
+}
+
+/*------------------------------------------------------------------------------------------------*/
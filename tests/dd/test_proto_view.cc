@@ -0,0 +1,137 @@
+#include <cstdint> // uint64_t
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct proto_view_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+  sdd::dd::context<C>& cxt;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  proto_view_test()
+    : m(sdd::manager<C>::init(small_conf<C>()))
+    , cxt(sdd::global<C>().sdd_context)
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+
+  /// @brief Get the identity of the view of a flat SDD.
+  static
+  typename sdd::flat_node<C>::id_type
+  view_identity(const sdd::SDD<C>& x)
+  {
+    return x.view().id();
+  }
+
+  /// @brief Get the unification identifier of an SDD.
+  static
+  std::uint64_t
+  unification_id(const sdd::SDD<C>& x)
+  {
+    return x.ptr()->id();
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(proto_view_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(proto_view_test, lazy_traversal)
+{
+  const SDD x = sum(cxt, {SDD(1, {0}, SDD(0, {0}, one)), SDD(1, {1}, SDD(0, {1}, one))});
+  const auto& arcs_cache = sdd::global<conf>().proto_arcs_cache;
+  const std::size_t cache_size = arcs_cache.size();
+
+  const auto view = x.view();
+  ASSERT_EQ(2u, view.size());
+  ASSERT_EQ(cache_size, arcs_cache.size());
+
+  // A single traversal doesn't materialize arcs.
+  std::vector<SDD> succs;
+  for (const auto& arc : view)
+  {
+    succs.push_back(arc.successor());
+  }
+  ASSERT_EQ(2u, succs.size());
+  ASSERT_NE(succs[0], succs[1]);
+  ASSERT_EQ(cache_size, arcs_cache.size());
+
+  // The second traversal does.
+  std::size_t i = 0;
+  for (const auto& arc : view)
+  {
+    ASSERT_EQ(succs[i++], arc.successor());
+  }
+  ASSERT_EQ(cache_size + 1, arcs_cache.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(proto_view_test, same_arcs)
+{
+  const SDD x = sum(cxt, { SDD(1, {0}, SDD(0, {0}, one)), SDD(1, {1}, SDD(0, {1}, one))
+                         , SDD(1, {2}, SDD(0, {1, 2}, one))});
+
+  const auto lazy = x.view();
+  const auto materialized = x.view();
+  const auto& arcs = materialized.arcs();
+  ASSERT_EQ(arcs.size(), lazy.size());
+
+  auto cit = arcs.cbegin();
+  for (auto lazy_cit = lazy.begin(); lazy_cit != lazy.end(); ++lazy_cit, ++cit)
+  {
+    // Arcs are returned by value, dereferencing twice decodes the same arc.
+    ASSERT_EQ(*cit, *lazy_cit);
+    ASSERT_EQ(*lazy_cit, *lazy_cit);
+  }
+  ASSERT_EQ(arcs.cend(), cit);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(proto_view_test, cache_statistics)
+{
+  const SDD x = sum(cxt, {SDD(1, {0}, SDD(0, {0}, one)), SDD(1, {1}, SDD(0, {1}, one))});
+  const auto misses = this->m.proto_arcs_cache_stats().total().misses;
+  const auto hits = this->m.proto_arcs_cache_stats().total().hits;
+
+  const auto v0 = x.view();
+  v0.arcs();
+  const auto v1 = x.view();
+  v1.arcs();
+  ASSERT_EQ(misses + 1, this->m.proto_arcs_cache_stats().total().misses);
+  ASSERT_EQ(hits + 1, this->m.proto_arcs_cache_stats().total().hits);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(proto_view_test, identity)
+{
+  const SDD x = sum(cxt, {SDD(1, {0}, SDD(0, {0}, one)), SDD(1, {1}, SDD(0, {1}, one))});
+  const SDD y = SDD(1, {0}, SDD(0, {0}, one));
+
+  // Views are identified by the unified SDD holding their node, not by its address.
+  ASSERT_TRUE(this->view_identity(x) == this->view_identity(x));
+  ASSERT_EQ(this->unification_id(x), this->view_identity(x).node);
+  ASSERT_FALSE(this->view_identity(x) == this->view_identity(y));
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,149 @@
+#include <algorithm> // sort
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/dd/sampler.hh"
+#include "sdd/manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct sampler_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+  sdd::dd::context<C>& cxt;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  sampler_test()
+    : m(sdd::manager<C>::init(small_conf<C>()))
+    , cxt(sdd::global<C>().sdd_context)
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(sampler_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(sampler_test, terminals)
+{
+  std::mt19937 gen(0);
+  {
+    const sdd::sampler<conf> s(zero);
+    ASSERT_EQ(0, s.size());
+    ASSERT_THROW(s(gen), std::out_of_range);
+    ASSERT_THROW(s.at(0), std::out_of_range);
+  }
+  {
+    const sdd::sampler<conf> s(one);
+    ASSERT_EQ(1, s.size());
+    ASSERT_TRUE(s(gen).empty());
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(sampler_test, all_elements)
+{
+  const SDD x = sum(cxt, { SDD(2, {0}, SDD(1, {0, 1}, SDD(0, {0}, one)))
+                         , SDD(2, {1, 2}, SDD(1, {2}, SDD(0, {1, 2, 3}, one)))});
+  const sdd::sampler<conf> s(x);
+  ASSERT_EQ(8, s.size());
+
+  std::vector<std::vector<unsigned int>> elements;
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    elements.push_back(s.at(i));
+  }
+  ASSERT_THROW(s.at(8), std::out_of_range);
+  std::sort(elements.begin(), elements.end());
+
+  const std::vector<std::vector<unsigned int>> expected
+    { {0, 0, 0}, {0, 1, 0}
+    , {1, 2, 1}, {1, 2, 2}, {1, 2, 3}
+    , {2, 2, 1}, {2, 2, 2}, {2, 2, 3}};
+  ASSERT_EQ(expected, elements);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(sampler_test, batch)
+{
+  const SDD x = sum(cxt, { SDD(2, {0}, SDD(1, {0, 1}, SDD(0, {0}, one)))
+                         , SDD(2, {1, 2}, SDD(1, {2}, SDD(0, {1, 2, 3}, one)))});
+  const sdd::sampler<conf> s(x);
+
+  // A batch draws the same elements, in the same order, as successive draws.
+  std::mt19937 gen0(42);
+  std::mt19937 gen1(42);
+  const auto batch = s(gen0, 100);
+  ASSERT_EQ(100u, batch.size());
+  for (const auto& element : batch)
+  {
+    ASSERT_EQ(s(gen1), element);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(sampler_test, uniform)
+{
+  // 1 element through the first arc, 3 through the second one.
+  const SDD x = sum(cxt, { SDD(1, {0}, SDD(0, {0}, one))
+                         , SDD(1, {1}, SDD(0, {1, 2, 3}, one))});
+  const sdd::sampler<conf> s(x);
+  std::mt19937 gen(0);
+  std::map<std::vector<unsigned int>, unsigned int> frequencies;
+  for (const auto& element : s(gen, 4000))
+  {
+    ++frequencies[element];
+  }
+  ASSERT_EQ(4u, frequencies.size());
+  for (const auto& f : frequencies)
+  {
+    ASSERT_LT(800u, f.second);
+    ASSERT_GT(1200u, f.second);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(sampler_test, large)
+{
+  // 2^100 elements.
+  SDD x = one;
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    x = SDD(i, {0, 1}, x);
+  }
+  const sdd::sampler<conf> s(x);
+  ASSERT_EQ(boost::multiprecision::cpp_int(1) << 100, s.size());
+
+  const auto last = s.at(s.size() - 1);
+  ASSERT_EQ(std::vector<unsigned int>(100, 1), last);
+
+  std::mt19937_64 gen(0);
+  for (const auto& element : s(gen, 10))
+  {
+    ASSERT_EQ(100u, element.size());
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
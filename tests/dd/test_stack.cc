@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+
+#include "sdd/dd/stack.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+using stack = sdd::dd::stack<int>;
+
+// Avoid the ODR-use of stack::inline_size in assertions.
+const std::size_t inline_size = stack::inline_size;
+
+} // namespace anonymous
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(stack_test, push)
+{
+  const stack s0;
+  ASSERT_EQ(s0, push(s0, 0));
+
+  const stack s1 = push(push(s0, 1), 2);
+  ASSERT_EQ(2u, size(s1));
+  ASSERT_EQ(2, head(s1));
+  ASSERT_EQ(1, s1[1]);
+  ASSERT_EQ(0, s1[2]);
+  ASSERT_EQ(inline_size, s1.elements.capacity());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(stack_test, shift)
+{
+  stack s;
+  for (int i = 1; i <= 4; ++i)
+  {
+    s = push(s, i);
+  }
+  ASSERT_LT(inline_size, s.elements.capacity());
+
+  // Zero the two deepest elements: they are removed and the remaining ones are moved back inline.
+  stack mask = push(push(stack(), 1), 1);
+  s.shift(mask, [](int lhs, int rhs){return lhs * rhs;});
+  ASSERT_EQ(2u, size(s));
+  ASSERT_EQ(4, s[0]);
+  ASSERT_EQ(3, s[1]);
+  ASSERT_EQ(inline_size, s.elements.capacity());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(stack_test, pop)
+{
+  stack s = push(push(push(stack(), 1), 2), 3);
+  s.pop();
+  ASSERT_EQ(push(push(stack(), 1), 2), s);
+}
+
+/*------------------------------------------------------------------------------------------------*/
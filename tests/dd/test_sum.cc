@@ -32,7 +32,41 @@ struct sum_test
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Successors of flat unions are summed as parallel tasks when the library is thread-safe.
+template <typename C>
+struct sum_parallel_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+  sdd::dd::context<C>& cxt;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  static
+  C
+  parallel_conf()
+  {
+    auto c = small_conf<C>();
+    c.nb_worker_threads = 2;
+    c.sum_grain_size = 1;
+    return c;
+  }
+
+  sum_parallel_test()
+    : m(sdd::manager<C>::init(parallel_conf()))
+    , cxt(sdd::global<C>().sdd_context)
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST_CASE(sum_test, configurations);
+TYPED_TEST_CASE(sum_parallel_test, configurations);
 #include "tests/macros.hh"
 #define flat_alpha_builder sdd::dd::alpha_builder<conf, values_type>
 #define hier_alpha_builder sdd::dd::alpha_builder<conf, SDD>
@@ -276,3 +310,43 @@ TYPED_TEST(sum_test, operators)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(sum_parallel_test, wide_flat_union)
+{
+  // The values of a successor depend on the top value modulo 10: 10 different successors are
+  // shared by the 100 top values, each of them with its own union of successors to compute.
+  std::vector<SDD> operands;
+  for (unsigned int a = 0; a < 100; ++a)
+  {
+    for (unsigned int b = 0; b <= a % 10; ++b)
+    {
+      operands.emplace_back(1, values_type {a}, SDD(0, values_type {b}, one));
+    }
+  }
+
+  // The expected result, built without any sum.
+  flat_alpha_builder builder;
+  for (unsigned int r = 0; r < 10; ++r)
+  {
+    std::vector<unsigned int> as;
+    for (unsigned int a = r; a < 100; a += 10)
+    {
+      as.push_back(a);
+    }
+    std::vector<unsigned int> bs;
+    for (unsigned int b = 0; b <= r; ++b)
+    {
+      bs.push_back(b);
+    }
+    builder.add( values_type(as.begin(), as.end())
+               , SDD(0, values_type(bs.begin(), bs.end()), one));
+  }
+  const SDD expected(1, std::move(builder));
+
+  ASSERT_EQ(expected, sdd::sum<conf>(operands.begin(), operands.end()));
+  // Again, with operands in a different order and results of previous unions in the cache.
+  ASSERT_EQ(expected, sdd::sum<conf>(operands.rbegin(), operands.rend()));
+  ASSERT_EQ(550u, expected.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+
+#include "sdd/hom/compile.hh"
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+#include "tests/hom/common_inductives.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct compilation_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  compilation_test()
+    : m(sdd::manager<C>::init(small_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(compilation_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(compilation_test, composition_chain)
+{
+  const order o(order_builder {"a", "b", "c"});
+  const SDD s0(2, {0}, SDD(1, {0}, SDD(0, {0}, one)));
+  const homomorphism a = inductive<conf>(targeted_incr<conf>("a", 1));
+  const homomorphism b = inductive<conf>(targeted_incr<conf>("b", 1));
+  const homomorphism c = inductive<conf>(targeted_incr<conf>("c", 1));
+
+  const homomorphism h0 = composition(composition(a, b), c);
+  const homomorphism h1 = composition(a, composition(b, c));
+  ASSERT_NE(h0, h1);
+  ASSERT_EQ(h1, sdd::compile(o, h0));
+  ASSERT_EQ(h1, sdd::compile(o, h1));
+  ASSERT_EQ(SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one))), sdd::compile(o, h0)(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(compilation_test, constant_folding)
+{
+  const order o(order_builder {"a", "b"});
+  const SDD s0(1, {0}, SDD(0, {0}, one));
+  const SDD s1(1, {1}, SDD(0, {1}, one));
+  const homomorphism a = inductive<conf>(targeted_incr<conf>("a", 1));
+  const homomorphism b = inductive<conf>(targeted_incr<conf>("b", 2));
+  {
+    const homomorphism h = composition(a, composition(b, constant(s1)));
+    ASSERT_EQ(constant(SDD(1, {2}, SDD(0, {3}, one))), sdd::compile(o, h));
+    ASSERT_EQ(h(o, s0), sdd::compile(o, h)(o, s0));
+    ASSERT_EQ(zero, sdd::compile(o, h)(o, zero));
+  }
+  {
+    // What is applied before the constant is kept: it may return |0|.
+    const homomorphism h = composition(composition(a, constant(s1)), b);
+    ASSERT_EQ( composition(constant(SDD(1, {2}, SDD(0, {1}, one))), b)
+             , sdd::compile(o, h));
+    ASSERT_EQ(h(o, s0), sdd::compile(o, h)(o, s0));
+  }
+  {
+    // A constant alone is left untouched.
+    ASSERT_EQ(constant(s1), sdd::compile(o, constant(s1)));
+    ASSERT_EQ(s1, constant(s1)(o, s0));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(compilation_test, locals_fusion)
+{
+  using ob = order_builder;
+  const order o(ob("x", ob("a")) << ob("y", ob("b")));
+  const homomorphism a1 = inductive<conf>(targeted_incr<conf>("a", 1));
+  const homomorphism a2 = inductive<conf>(targeted_incr<conf>("a", 2));
+  const homomorphism b1 = inductive<conf>(targeted_incr<conf>("b", 1));
+  {
+    const homomorphism h = composition(local("x", o, a1), local("x", o, a2));
+    ASSERT_EQ(local("x", o, composition(a1, a2)), sdd::compile(o, h));
+  }
+  {
+    const homomorphism h = composition(local("x", o, a1), local("y", o, b1));
+    ASSERT_EQ(h, sdd::compile(o, h));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -55,6 +55,11 @@ TYPED_TEST(hom_saturation_fixpoint_test, construction)
     ASSERT_NE( saturation_fixpoint<conf>(0, id, g1.begin(), g1.end(), id)
              , saturation_fixpoint<conf>(0, id, g2.begin(), g2.end(), id));
   }
+  {
+    std::vector<homomorphism> g {id, inductive<conf>(targeted_noop<conf>("0"))};
+    ASSERT_NE( saturation_fixpoint<conf>(0, id, g.begin(), g.end(), id)
+             , saturation_fixpoint<conf>(0, id, g.begin(), g.end(), id, true));
+  }
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -93,3 +98,31 @@ TYPED_TEST(hom_saturation_fixpoint_test, evaluation)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_saturation_fixpoint_test, chaining)
+{
+  const order o(order_builder {"a", "b", "c"});
+  SDD s0(2, {0}, SDD(1, {0}, SDD(0, {0}, one)));
+
+  const auto f = fixpoint(sum<conf>(o, {inductive<conf>(targeted_incr<conf>("c", 1)), id}));
+  const std::vector<homomorphism> g{inductive<conf>(targeted_incr<conf>("b", 1))};
+  const auto h = saturation_fixpoint(1, f, g.begin(), g.end(), id);
+  const auto chaining_h = saturation_fixpoint(1, f, g.begin(), g.end(), id, true);
+
+  auto& stats = this->m.saturation_stats();
+  stats.reset();
+  const auto res = h(o, s0);
+  const auto rounds = stats.rounds();
+  ASSERT_EQ(1u, stats.evaluations());
+  ASSERT_EQ(3u, rounds);
+
+  stats.reset();
+  ASSERT_EQ(res, chaining_h(o, s0));
+  ASSERT_EQ(1u, stats.evaluations());
+  ASSERT_EQ(2u, stats.rounds());
+  // b goes from {0} to {0,1,2} with the first G application, then G doesn't add anything.
+  ASSERT_EQ(4u, stats.g_applications());
+  ASSERT_EQ(SDD(2, {0}, SDD(1, {0,1,2}, SDD(0, {0,1,2}, one))), res);
+}
+
+/*------------------------------------------------------------------------------------------------*/
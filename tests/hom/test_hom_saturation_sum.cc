@@ -36,7 +36,42 @@ struct hom_saturation_sum_test
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Operands of Saturation Sums and Intersections are evaluated as parallel tasks when the
+/// library is thread-safe.
+template <typename C>
+struct hom_parallel_saturation_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  static
+  C
+  parallel_conf()
+  {
+    auto c = small_conf<C>();
+    c.parallel_saturation = true;
+    c.nb_worker_threads = 2;
+    return c;
+  }
+
+  hom_parallel_saturation_test()
+    : m(sdd::manager<C>::init(parallel_conf()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST_CASE(hom_saturation_sum_test, configurations);
+TYPED_TEST_CASE(hom_parallel_saturation_test, configurations);
 #include "tests/macros.hh"
 
 /*------------------------------------------------------------------------------------------------*/
@@ -77,3 +112,35 @@ TYPED_TEST(hom_saturation_sum_test, evaluation)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_parallel_saturation_test, evaluation)
+{
+  using optional = sdd::hom::optional_homomorphism<conf>;
+  const order o(order_builder {"a", "b", "c"});
+  const SDD s0(2, {0}, SDD(1, {0}, SDD(0, {0}, one)));
+  std::vector<homomorphism> empty_g;
+  const auto f = saturation_sum<conf>( 0, inductive<conf>(targeted_incr<conf>("c", 1))
+                                     , empty_g.begin(), empty_g.end(), optional());
+  std::vector<homomorphism> g { inductive<conf>(targeted_incr<conf>("b", 1))
+                              , inductive<conf>(targeted_incr<conf>("b", 2))
+                              , inductive<conf>(targeted_noop<conf>("b"))};
+  {
+    const auto h = saturation_sum<conf>(1, f, g.begin(), g.end(), optional());
+    const SDD ref = SDD(2, {0}, SDD(1, {0,1,2}, SDD(0, {0}, one)))
+                  + SDD(2, {0}, SDD(1, {0}, SDD(0, {1}, one)));
+    ASSERT_EQ(ref, h(o, s0));
+  }
+  {
+    const auto h = saturation_intersection<conf>(1, f, g.begin(), g.end(), optional());
+    ASSERT_EQ(zero, h(o, s0));
+  }
+  {
+    std::vector<homomorphism> noops { inductive<conf>(targeted_noop<conf>("b"))
+                                    , inductive<conf>(targeted_noop<conf>("c"))};
+    const auto h = saturation_intersection<conf>( 1, optional(), noops.begin(), noops.end()
+                                                , optional());
+    ASSERT_EQ(s0, h(o, s0));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -31,6 +31,32 @@ TYPED_TEST(hom_expression_test, simple_construction)
 
 /*------------------------------------------------------------------------------------------------*/
 
+TYPED_TEST(hom_expression_test, simple_skip)
+{
+  using ob = order_builder;
+  {
+    const auto l = {"a", "b"};
+    order o(order_builder {"a", "b", "c", "d"});
+    const auto h = expression<conf>(o, evaluator<conf>(ast1), l.begin(), l.end(), "c");
+    ASSERT_FALSE(h.skip(o));                      // a
+    ASSERT_FALSE(h.skip(o.next().next()));        // c
+    ASSERT_TRUE(h.skip(o.next().next().next()));  // d
+  }
+  {
+    const auto l = {"a", "b"};
+    order o(ob("x", ob {"a", "b"}) << ob("y", ob {"c"}) << ob("z", ob {"d"}));
+    const auto h = expression<conf>(o, evaluator<conf>(ast1), l.begin(), l.end(), "c");
+    ASSERT_FALSE(h.skip(o));                      // x, contains a
+    ASSERT_FALSE(h.skip(o.nested()));             // a
+    ASSERT_FALSE(h.skip(o.next()));               // y, contains c
+    ASSERT_FALSE(h.skip(o.next().nested()));      // c
+    ASSERT_TRUE(h.skip(o.next().next()));         // z
+    ASSERT_TRUE(h.skip(o.next().next().nested())); // d
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST(hom_expression_test, simple_flat_one_path)
 {
   const auto _ = 42; // don't care value
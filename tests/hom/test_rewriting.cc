@@ -38,7 +38,37 @@ struct rewriting_test
 
 /*------------------------------------------------------------------------------------------------*/
 
+template <typename C>
+struct chaining_rewriting_test
+  : public testing::Test
+{
+  typedef C configuration_type;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  static
+  C
+  chaining_conf()
+  {
+    C c = small_conf<C>();
+    c.saturation_chaining = true;
+    return c;
+  }
+
+  chaining_rewriting_test()
+    : m(sdd::manager<C>::init(chaining_conf()))
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST_CASE(rewriting_test, configurations);
+TYPED_TEST_CASE(chaining_rewriting_test, configurations);
 #include "tests/macros.hh"
 
 /*------------------------------------------------------------------------------------------------*/
@@ -176,3 +206,23 @@ TYPED_TEST(rewriting_test, transitive_closure)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(chaining_rewriting_test, fixpoint)
+{
+  const order o(order_builder {"a", "b", "c"});
+  const homomorphism h0
+    = fixpoint(sum<conf>( o
+                        , { id
+                          , inductive<conf>(targeted_incr<conf>("a", 1))
+                          , inductive<conf>(targeted_incr<conf>("b", 1))}));
+  const homomorphism h1 = sdd::rewrite(o, h0);
+  ASSERT_NE(h0, h1);
+  // The configuration selects the chaining Saturation Fixpoint.
+  ASSERT_TRUE(sdd::mem::variant_cast<const sdd::hom::_saturation_fixpoint<conf>>(*h1).chaining());
+
+  const SDD s0(2, {0}, SDD(1, {0}, SDD(0, {0}, one)));
+  ASSERT_EQ(h0(o, s0), h1(o, s0));
+  ASSERT_EQ(SDD(2, {0,1,2}, SDD(1, {0,1,2}, SDD(0, {0}, one))), h1(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
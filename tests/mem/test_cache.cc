@@ -274,7 +274,7 @@ TEST(cache, filters)
     ASSERT_FALSE((true_filter_2::used));
   }
   {
-    cache<context, operation, error, filter_0> c(cxt, "c", 100);
+    cache<context, operation, error, lfu_eviction, filter_0> c(cxt, "c", 100);
     const auto& stats = c.statistics().rounds.front();
 
     ASSERT_EQ(2u, c(operation(1)));
@@ -293,7 +293,7 @@ TEST(cache, filters)
     ASSERT_EQ(2u, stats.filtered);
   }
   {
-    cache<context, operation, error, filter_0, filter_1> c(cxt, "c", 100);
+    cache<context, operation, error, lfu_eviction, filter_0, filter_1> c(cxt, "c", 100);
     const auto& stats = c.statistics().rounds.front();
 
     ASSERT_EQ(2u, c(operation(1)));
@@ -332,7 +332,7 @@ TEST(cache, exception)
     ASSERT_THROW(c(operation(6666)), error);
   }
   {
-    cache<context, operation, error, filter_6666> c(cxt, "c", 100);
+    cache<context, operation, error, lfu_eviction, filter_6666> c(cxt, "c", 100);
     ASSERT_THROW(c(operation(6666)), error);
   }
 }
@@ -349,5 +349,147 @@ TEST(cache, cleanup)
   ASSERT_EQ(3u, c.statistics().cleanups());
 }
 
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, clock_eviction)
+{
+  cache<context, operation, error, clock_eviction> c(cxt, "c", 1024);
+  for (std::size_t i = 0; i < 922; ++i)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+  }
+  ASSERT_EQ(922u, c.size());
+  ASSERT_EQ(0u, c.statistics().cleanups());
+
+  // Give a second chance to operation(0).
+  ASSERT_EQ(1u, c(operation(0)));
+  ASSERT_EQ(1u, c.statistics().rounds.front().hits);
+
+  // Evict operation(1) rather than operation(0).
+  ASSERT_EQ(923u, c(operation(922)));
+  ASSERT_EQ(922u, c.size());
+  ASSERT_EQ(1u, c(operation(0)));
+  ASSERT_EQ(2u, c.statistics().rounds.front().hits);
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(2u, c.statistics().rounds.front().hits);
+
+  for (std::size_t i = 923; i < 2048; ++i)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+  }
+  ASSERT_EQ(922u, c.size());
+  ASSERT_EQ(2u, c.statistics().cleanups());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, slru_eviction)
+{
+  cache<context, operation, error, slru_eviction> c(cxt, "c", 1024);
+  for (std::size_t i = 0; i < 922; ++i)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+  }
+  ASSERT_EQ(922u, c.size());
+
+  // Promote operation(0) to the protected segment.
+  ASSERT_EQ(1u, c(operation(0)));
+
+  // Only probationary entries are evicted.
+  for (std::size_t i = 922; i < 2048; ++i)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+  }
+  ASSERT_EQ(922u, c.size());
+  ASSERT_EQ(2u, c.statistics().cleanups());
+  const auto hits = c.statistics().total().hits;
+  ASSERT_EQ(1u, c(operation(0)));
+  ASSERT_EQ(hits + 1, c.statistics().total().hits);
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, resize)
+{
+  cache<context, operation, error> c(cxt, "c", 128);
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+  }
+  ASSERT_EQ(128u, c.capacity());
+
+  // Growing keeps all entries.
+  c.resize(1024);
+  ASSERT_EQ(1024u, c.capacity());
+  ASSERT_EQ(100u, c.size());
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+  }
+  ASSERT_EQ(100u, c.statistics().rounds.front().hits);
+  for (std::size_t i = 100; i < 900; ++i)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+  }
+  ASSERT_EQ(900u, c.size());
+  ASSERT_EQ(0u, c.statistics().cleanups());
+
+  // Shrinking below the number of entries removes them all.
+  c.resize(64);
+  ASSERT_EQ(64u, c.capacity());
+  ASSERT_EQ(0u, c.size());
+  ASSERT_EQ(2u, c.statistics().resizes);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename Eviction>
+void
+adaptive_growth()
+{
+  cache<context, operation, error, Eviction> c(cxt, "c", 128);
+  c.adaptive(0.5, 1024);
+
+  // Only misses.
+  for (std::size_t i = 0; i < 6000; ++i)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+  }
+  ASSERT_EQ(1024u, c.capacity());
+  ASSERT_EQ(3u, c.statistics().resizes);
+  ASSERT_GE(922u, c.size());
+
+  // Recent entries are still found.
+  const auto hits = c.statistics().total().hits;
+  ASSERT_EQ(6000u, c(operation(5999)));
+  ASSERT_EQ(hits + 1, c.statistics().total().hits);
+}
+
+TEST(cache, adaptive)
+{
+  adaptive_growth<lfu_eviction>();
+  adaptive_growth<clock_eviction>();
+  adaptive_growth<slru_eviction>();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, not_adaptive_when_hitting)
+{
+  cache<context, operation, error> c(cxt, "c", 128);
+  c.adaptive(0.5, 1024);
+
+  // Each operation is looked up 3 times, the miss rate is about 1/3.
+  for (std::size_t i = 0; i < 6000; ++i)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      ASSERT_EQ(static_cast<std::size_t>(i + 1), c(operation(i)));
+    }
+  }
+  ASSERT_EQ(128u, c.capacity());
+  ASSERT_EQ(0u, c.statistics().resizes);
+}
 
 /*------------------------------------------------------------------------------------------------*/
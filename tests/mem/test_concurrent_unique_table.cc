@@ -0,0 +1,177 @@
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/mem/concurrent_unique_table.hh"
+#include "sdd/mem/open_hash_table.hh"
+#include "sdd/mem/ref_counted.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+// Spread hashes over all shards.
+struct spread_hash
+{
+  std::size_t
+  operator()(int i)
+  const noexcept
+  {
+    return static_cast<std::size_t>(i) * 0x9e3779b97f4a7c15ull;
+  }
+};
+
+using unique = sdd::mem::ref_counted<int, spread_hash>;
+
+constexpr std::size_t nb_threads = 8;
+constexpr int nb_values = 1000;
+
+template <typename Table>
+unique&
+unify(Table& ut, int i)
+{
+  char* addr = ut.allocate(0);
+  return ut(new (addr) unique(i));
+}
+
+template <typename Table>
+void
+unify_and_erase()
+{
+  Table ut(100);
+  std::vector<const unique*> refs(nb_threads * nb_values);
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < nb_threads; ++t)
+  {
+    threads.emplace_back([&, t]
+                         {
+                           for (int i = 0; i < nb_values; ++i)
+                           {
+                             refs[t * nb_values + i] = &unify(ut, i);
+                           }
+                         });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  threads.clear();
+
+  for (std::size_t t = 0; t < nb_threads; ++t)
+  {
+    for (int i = 0; i < nb_values; ++i)
+    {
+      ASSERT_EQ(refs[i], refs[t * nb_values + i]);
+      ASSERT_EQ(i, refs[t * nb_values + i]->data());
+    }
+  }
+  ASSERT_EQ(static_cast<std::size_t>(nb_values), ut.stats().size);
+  ASSERT_EQ(nb_threads * nb_values, ut.stats().access);
+  ASSERT_EQ((nb_threads - 1) * nb_values, ut.stats().hits);
+  ASSERT_EQ(static_cast<std::size_t>(nb_values), ut.stats().misses);
+
+  // Each thread releases its references, the last one erases the data.
+  for (std::size_t t = 0; t < nb_threads; ++t)
+  {
+    threads.emplace_back([&, t]
+                         {
+                           for (int i = 0; i < nb_values; ++i)
+                           {
+                             ut.erase(*refs[t * nb_values + i]);
+                           }
+                         });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  ASSERT_EQ(0u, ut.stats().size);
+}
+
+} // namespace anonymous
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(concurrent_unique_table_test, chaining)
+{
+  unify_and_erase<sdd::mem::concurrent_unique_table<unique>>();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(concurrent_unique_table_test, open_addressing)
+{
+  unify_and_erase< sdd::mem::concurrent_unique_table< unique
+                                                    , sdd::mem::open_hash_table<unique>>>();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(concurrent_unique_table_test, deferred_gc)
+{
+  sdd::mem::concurrent_unique_table<unique> ut(100, false, nb_threads * nb_values);
+  std::vector<const unique*> refs(nb_values);
+  for (int i = 0; i < nb_values; ++i)
+  {
+    refs[i] = &unify(ut, i);
+  }
+  for (int i = 0; i < nb_values; ++i)
+  {
+    ut.erase(*refs[i]);
+  }
+  ASSERT_EQ(static_cast<std::size_t>(nb_values), ut.stats().size);
+  ASSERT_EQ(static_cast<std::size_t>(nb_values), ut.stats().dead);
+
+  // Resurrect all data in parallel.
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < nb_threads; ++t)
+  {
+    threads.emplace_back([&]
+                         {
+                           for (int i = 0; i < nb_values; ++i)
+                           {
+                             ut.erase(unify(ut, i));
+                           }
+                         });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  ASSERT_EQ(static_cast<std::size_t>(nb_values), ut.stats().size);
+  ASSERT_EQ(static_cast<std::size_t>(nb_values), ut.stats().dead);
+  ASSERT_LE(static_cast<std::size_t>(nb_values), ut.stats().resurrections);
+
+  ASSERT_EQ(static_cast<std::size_t>(nb_values), ut.collect());
+  ASSERT_EQ(0u, ut.stats().size);
+  ASSERT_EQ(0u, ut.stats().dead);
+  ASSERT_EQ(1u, ut.stats().sweeps);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(concurrent_unique_table_test, shards)
+{
+  // Integers' std::hash is the identity, thus hashes have their highest bits empty.
+  using identity_unique = sdd::mem::ref_counted<int>;
+  sdd::mem::concurrent_unique_table<identity_unique> ut(100);
+  std::set<std::size_t> shards;
+  std::vector<const identity_unique*> refs;
+  for (int i = 0; i < nb_values; ++i)
+  {
+    char* addr = ut.allocate(0);
+    refs.push_back(&ut(new (addr) identity_unique(i)));
+    shards.insert(ut.shard_index(std::hash<identity_unique>()(*refs.back())));
+  }
+  ASSERT_LT(1u, shards.size());
+  for (const auto x : refs)
+  {
+    ut.erase(*x);
+  }
+  ASSERT_EQ(0u, ut.stats().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
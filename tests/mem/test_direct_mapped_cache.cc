@@ -0,0 +1,178 @@
+#include "gtest/gtest.h"
+
+#include "sdd/mem/direct_mapped_cache.hh"
+
+using namespace sdd::mem;
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+struct context
+{
+};
+
+context cxt;
+
+struct error
+  : public std::exception
+{
+  const char*
+  what()
+  const noexcept
+  {
+    return "";
+  }
+
+  template <typename Operation>
+  void
+  add_step(Operation&&)
+  {
+  }
+};
+
+struct operation
+{
+  typedef std::size_t result_type;
+
+  const std::size_t i_;
+
+  operation(std::size_t i)
+  	: i_(i)
+  {
+  }
+
+  std::size_t
+  operator()(context&)
+  const
+  {
+    if (i_ == 6666)
+    {
+      throw error();
+    }
+    return i_ + 1;
+  }
+
+  bool
+  operator==(const operation& op)
+  const
+  {
+    return i_ == op.i_;
+  }
+};
+
+struct filter_0
+{
+  bool
+  operator()(const operation& op)
+  const noexcept
+  {
+    return op.i_ != 0;
+  }
+};
+
+} // namespace anonymous
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <>
+struct hash<operation>
+{
+  std::size_t
+  operator()(const operation& op)
+  const noexcept
+  {
+    return op.i_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(direct_mapped_cache, insertion)
+{
+  direct_mapped_cache<context, operation, error> c(cxt, "c", 100);
+  const auto& stats = c.statistics().rounds.front();
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(0u, stats.hits);
+  ASSERT_EQ(1u, stats.misses);
+  ASSERT_EQ(1u, c.size());
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(1u, stats.hits);
+  ASSERT_EQ(1u, stats.misses);
+
+  ASSERT_EQ(3u, c(operation(2)));
+  ASSERT_EQ(1u, stats.hits);
+  ASSERT_EQ(2u, stats.misses);
+  ASSERT_EQ(2u, c.size());
+
+  c.clear();
+  ASSERT_EQ(0u, c.size());
+  ASSERT_EQ(3u, c(operation(2)));
+  ASSERT_EQ(1u, stats.hits);
+  ASSERT_EQ(3u, stats.misses);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(direct_mapped_cache, overwrite)
+{
+  // 100 is rounded up to 128 slots.
+  direct_mapped_cache<context, operation, error> c(cxt, "c", 100);
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(130u, c(operation(129)));
+  ASSERT_EQ(1u, c.size());
+  ASSERT_DOUBLE_EQ(1.0 / 128, c.load_factor());
+
+  // operation(1) has been overwritten by operation(129).
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(0u, c.statistics().rounds.front().hits);
+  ASSERT_EQ(3u, c.statistics().rounds.front().misses);
+
+  // A new round starts when half of the slots have been overwritten.
+  for (std::size_t i = 2; i < 64; ++i)
+  {
+    ASSERT_EQ(i + 1, c(operation(i)));
+  }
+  ASSERT_EQ(0u, c.statistics().cleanups());
+  for (std::size_t i = 2; i < 64; ++i)
+  {
+    ASSERT_EQ(128 + i + 1, c(operation(128 + i)));
+  }
+  ASSERT_EQ(1u, c.statistics().cleanups());
+  ASSERT_EQ(63u, c.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(direct_mapped_cache, filters)
+{
+  direct_mapped_cache<context, operation, error, filter_0> c(cxt, "c", 100);
+  const auto& stats = c.statistics().rounds.front();
+
+  ASSERT_EQ(1u, c(operation(0)));
+  ASSERT_EQ(1u, c(operation(0)));
+  ASSERT_EQ(0u, stats.hits);
+  ASSERT_EQ(0u, stats.misses);
+  ASSERT_EQ(2u, stats.filtered);
+  ASSERT_EQ(0u, c.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(direct_mapped_cache, exception)
+{
+  direct_mapped_cache<context, operation, error> c(cxt, "c", 100);
+  ASSERT_THROW(c(operation(6666)), error);
+  ASSERT_EQ(0u, c.statistics().rounds.front().misses);
+  ASSERT_EQ(0u, c.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
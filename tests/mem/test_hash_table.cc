@@ -436,3 +436,150 @@ TEST(hash_table, clear_and_dispose)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TEST(hash_table, no_rehash)
+{
+  std::vector<foo> vec;
+  vec.reserve(100);
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    vec.push_back(foo{i});
+  }
+
+  foo_hash_table ht{16};
+  for (auto& f : vec)
+  {
+    ht.insert(f);
+  }
+
+  ASSERT_EQ(16u, ht.bucket_count());
+  ASSERT_FALSE(ht.rehashing());
+  ASSERT_EQ(100u, ht.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(hash_table, incremental_rehash)
+{
+  std::vector<foo> vec;
+  vec.reserve(1000);
+  for (unsigned int i = 0; i < 1000; ++i)
+  {
+    vec.push_back(foo{i});
+  }
+
+  foo_hash_table ht{16, true};
+  bool seen_rehashing = false;
+  for (auto& f : vec)
+  {
+    ht.insert(f);
+    seen_rehashing = seen_rehashing or ht.rehashing();
+
+    // All elements must be reachable, whether they are in old or new buckets.
+    ASSERT_EQ(f, *ht.find(f));
+    ASSERT_EQ(ht.size(), static_cast<std::size_t>(std::distance(ht.begin(), ht.end())));
+  }
+
+  ASSERT_TRUE(seen_rehashing);
+  ASSERT_EQ(1000u, ht.size());
+  ASSERT_LE(1024u, ht.bucket_count());
+  for (auto& f : vec)
+  {
+    const auto it = ht.find(f);
+    ASSERT_NE(ht.end(), it);
+    ASSERT_EQ(&f, &*it);
+  }
+
+  // Inserting an equal element doesn't add it.
+  foo f{42};
+  const auto insertion = ht.insert(f);
+  ASSERT_FALSE(insertion.second);
+  ASSERT_EQ(&vec[42], &*insertion.first);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(hash_table, erase_while_rehashing)
+{
+  std::vector<bar> vec;
+  vec.reserve(100);
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    vec.push_back(bar(i, i));
+  }
+
+  bar_hash_table ht{16, true};
+  unsigned int i = 0;
+  for (; i < 13; ++i)
+  {
+    ht.insert(vec[i]);
+  }
+  ht.insert(vec[i++]);
+  ASSERT_TRUE(ht.rehashing());
+
+  // Erase elements, some of them are still in old buckets.
+  for (unsigned int j = 0; j < i; j += 2)
+  {
+    const auto it = ht.find(vec[j]);
+    ASSERT_NE(ht.end(), it);
+    ht.erase(it);
+    ASSERT_EQ(ht.end(), ht.find(vec[j]));
+  }
+
+  for (; i < 100; ++i)
+  {
+    ht.insert(vec[i]);
+  }
+
+  ASSERT_EQ(93u, ht.size());
+  ASSERT_EQ(93u, std::distance(ht.begin(), ht.end()));
+
+  std::size_t cpt = 0;
+  ht.clear_and_dispose([&cpt](bar*){++cpt;});
+  ASSERT_EQ(93u, cpt);
+  ASSERT_EQ(0u, ht.size());
+  ASSERT_EQ(ht.end(), ht.begin());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(hash_table, explicit_rehash)
+{
+  std::vector<bar> vec;
+  vec.reserve(100);
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    vec.push_back(bar(i, i));
+  }
+
+  bar_hash_table ht{16, true};
+  unsigned int i = 0;
+  for (; i < 14; ++i)
+  {
+    ht.insert(vec[i]);
+  }
+  ASSERT_TRUE(ht.rehashing());
+
+  // Complete the incremental rehash.
+  ht.rehash(100);
+  ASSERT_FALSE(ht.rehashing());
+  ASSERT_EQ(128u, ht.bucket_count());
+  ASSERT_EQ(14u, ht.size());
+  ASSERT_EQ(14u, std::distance(ht.begin(), ht.end()));
+
+  for (; i < 100; ++i)
+  {
+    ht.insert(vec[i]);
+  }
+
+  // Shrink.
+  ht.rehash(8);
+  ASSERT_EQ(8u, ht.bucket_count());
+  ASSERT_EQ(100u, ht.size());
+  for (auto& b : vec)
+  {
+    ASSERT_EQ(&b, &*ht.find(b));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
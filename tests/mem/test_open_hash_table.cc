@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/mem/open_hash_table.hh"
+
+using namespace sdd::mem;
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace /* anonymous */ {
+
+struct foo
+{
+  unsigned int data;
+
+  foo(unsigned int d)
+    : data(d)
+  {}
+
+  bool
+  operator==(const foo& other)
+  const noexcept
+  {
+    return data == other.data;
+  }
+
+  bool
+  operator<(const foo& other)
+  const noexcept
+  {
+    return data < other.data;
+  }
+};
+
+std::ostream&
+operator<<(std::ostream& os, const foo& f)
+{
+  return os << "foo(" << f.data <<")";
+}
+
+struct bar
+{
+  unsigned int data;
+  std::size_t hash;
+
+  bar(unsigned int d, std::size_t h)
+    : data(d)
+    , hash(h)
+  {}
+
+  bool
+  operator==(const bar& other)
+  const noexcept
+  {
+    return data == other.data;
+  }
+
+  bool
+  operator<(const bar& other)
+  const noexcept
+  {
+    return data < other.data;
+  }
+};
+
+std::ostream&
+operator<<(std::ostream& os, const bar& f)
+{
+  return os << "bar(" << f.data <<")";
+}
+
+} // namespace anonymous
+
+namespace std
+{
+
+template <>
+struct hash<foo>
+{
+  std::size_t
+  operator()(const foo& f)
+  const noexcept
+  {
+    return std::hash<unsigned int>()(f.data);
+  }
+};
+
+template <>
+struct hash<bar>
+{
+  std::size_t
+  operator()(const bar& b)
+  const noexcept
+  {
+    return b.hash;
+  }
+};
+
+} // namespace std
+
+typedef open_hash_table<foo> foo_hash_table;
+typedef open_hash_table<bar> bar_hash_table;
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(open_hash_table, creation)
+{
+  foo_hash_table ht{100};
+  ASSERT_EQ(0u, ht.size());
+  ASSERT_EQ(ht.end(), ht.begin());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(open_hash_table, simple_insertion)
+{
+  foo_hash_table ht{10};
+
+  foo f1{42};
+  foo f2{42};
+  foo f3{43};
+
+  auto insertion = ht.insert(f1);
+  ASSERT_EQ(1u, ht.size());
+  ASSERT_TRUE(insertion.second);
+  ASSERT_EQ(f1, *insertion.first);
+
+  insertion = ht.insert(f2);
+  ASSERT_EQ(1u, ht.size());
+  ASSERT_FALSE(insertion.second);
+  ASSERT_EQ(&f1, &*insertion.first);
+
+  insertion = ht.insert(f3);
+  ASSERT_EQ(2u, ht.size());
+  ASSERT_TRUE(insertion.second);
+  ASSERT_EQ(&f3, &*insertion.first);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(open_hash_table, grow)
+{
+  std::vector<bar> vec;
+  vec.reserve(100);
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    vec.push_back(bar(i, i % 16));
+  }
+
+  bar_hash_table ht{16};
+  for (auto& b : vec)
+  {
+    ASSERT_TRUE(ht.insert(b).second);
+  }
+
+  ASSERT_EQ(100u, ht.size());
+  ASSERT_LE(128u, ht.bucket_count());
+  ASSERT_EQ(100u, std::distance(ht.begin(), ht.end()));
+  for (auto& b : vec)
+  {
+    ASSERT_EQ(&b, &*ht.find(b));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(open_hash_table, erase)
+{
+  // Collisions and wrap around the end of slots.
+  std::vector<bar> vec;
+  vec.reserve(10);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    vec.push_back(bar(i, 30));
+  }
+  for (unsigned int i = 5; i < 10; ++i)
+  {
+    vec.push_back(bar(i, 31));
+  }
+
+  bar_hash_table ht{32};
+  for (auto& b : vec)
+  {
+    ht.insert(b);
+  }
+
+  for (unsigned int i = 0; i < 10; i += 3)
+  {
+    const auto it = ht.find(vec[i]);
+    ASSERT_NE(ht.end(), it);
+    ht.erase(it);
+    ASSERT_EQ(ht.end(), ht.find(vec[i]));
+  }
+
+  ASSERT_EQ(6u, ht.size());
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    if (i % 3 != 0)
+    {
+      ASSERT_EQ(&vec[i], &*ht.find(vec[i]));
+    }
+  }
+
+  std::vector<bar> content(ht.begin(), ht.end());
+  std::sort(content.begin(), content.end());
+  ASSERT_EQ(6u, content.size());
+  ASSERT_EQ(vec[1], content[0]);
+  ASSERT_EQ(vec[8], content[5]);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(open_hash_table, clear_and_dispose)
+{
+  std::vector<foo> vec;
+  vec.reserve(16);
+  for (unsigned int i = 0; i < 16; ++i)
+  {
+    vec.push_back(foo{i});
+  }
+
+  foo_hash_table ht{8};
+  for (auto& f : vec)
+  {
+    ht.insert(f);
+  }
+
+  std::size_t cpt = 0;
+  ht.clear_and_dispose([&cpt](foo*){++cpt;});
+
+  ASSERT_EQ(0u, ht.size());
+  ASSERT_EQ(16u, cpt);
+
+  for (auto& f : vec)
+  {
+    ASSERT_EQ(ht.end(), ht.find(f));
+  }
+
+  ASSERT_EQ(ht.end(), ht.begin());
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -28,6 +28,17 @@ struct unique
     --ref_counter_;
   }
 
+  bool
+  decrement_shared_reference_counter()
+  {
+    if (ref_counter_ > 1)
+    {
+      --ref_counter_;
+      return true;
+    }
+    return false;
+  }
+
   bool
   is_not_referenced()
   const
@@ -56,12 +67,20 @@ struct unique_table<unique>
   unique&
   operator()(unique& x)
   {
+#if defined LIBSDD_THREAD_SAFE
+    // ptr expects the unique table to count references when the library is thread-safe.
+    x.increment_reference_counter();
+#endif
     return x;
   }
 
   void
-  erase(const unique&)
+  erase(const unique& x)
   {
+#if defined LIBSDD_THREAD_SAFE
+    // The last reference is released by the unique table when the library is thread-safe.
+    --const_cast<unique&>(x).ref_counter_;
+#endif
     ++nb_deletions_;
   }
 
@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/mem/slab_allocator.hh"
+
+using sdd::mem::slab_allocator;
+
+namespace {
+
+// Avoid the ODR-use of static members in assertions.
+const std::size_t page_size = slab_allocator::default_page_size;
+const std::size_t huge_page_size = slab_allocator::huge_page_size;
+
+} // namespace anonymous
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(slab_allocator_test, contiguous)
+{
+  slab_allocator a;
+  char* b0 = a.allocate(24);
+  char* b1 = a.allocate(8);
+  char* b2 = a.allocate(100);
+  const auto rounded = [](std::size_t s)
+                         {
+                           return (s + slab_allocator::alignment - 1) / slab_allocator::alignment
+                                * slab_allocator::alignment;
+                         };
+  ASSERT_EQ(b0 + rounded(24), b1);
+  ASSERT_EQ(b1 + rounded(8), b2);
+  ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(b2) % slab_allocator::alignment);
+  ASSERT_EQ(page_size, a.capacity());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(slab_allocator_test, reuse)
+{
+  slab_allocator a;
+  char* b0 = a.allocate(24);
+  char* b1 = a.allocate(24);
+  a.deallocate(b0, 24);
+  a.deallocate(b1, 24);
+
+  // Blocks of the same size class are reused, the last released first.
+  ASSERT_EQ(b1, a.allocate(20));
+  ASSERT_EQ(b0, a.allocate(24));
+
+  // Blocks of another size class are not.
+  char* b2 = a.allocate(64);
+  ASSERT_NE(b0, b2);
+  ASSERT_NE(b1, b2);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(slab_allocator_test, pages)
+{
+  slab_allocator a;
+  std::vector<char*> blocks;
+  const std::size_t nb = 2 * page_size / 64;
+  for (std::size_t i = 0; i < nb; ++i)
+  {
+    blocks.push_back(a.allocate(64));
+    blocks.back()[63] = 'x';
+  }
+  ASSERT_EQ(2 * page_size, a.capacity());
+  for (auto b : blocks)
+  {
+    a.deallocate(b, 64);
+  }
+  for (std::size_t i = 0; i < nb; ++i)
+  {
+    a.allocate(64);
+  }
+  ASSERT_EQ(2 * page_size, a.capacity());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(slab_allocator_test, large_blocks)
+{
+  slab_allocator a;
+  char* b = a.allocate(slab_allocator::max_block_size + 1);
+  b[slab_allocator::max_block_size] = 'x';
+  ASSERT_EQ(0u, a.capacity());
+  a.deallocate(b, slab_allocator::max_block_size + 1);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(slab_allocator_test, huge_pages)
+{
+  slab_allocator a(true);
+  char* b = a.allocate(32);
+  ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(b) % huge_page_size);
+  ASSERT_EQ(huge_page_size, a.capacity());
+}
+
+/*------------------------------------------------------------------------------------------------*/
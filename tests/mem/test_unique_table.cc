@@ -1,6 +1,10 @@
+#include <cstdint>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "sdd/mem/hash_table.hh"
+#include "sdd/mem/open_hash_table.hh"
 #include "sdd/mem/unique_table.hh"
 
 /*------------------------------------------------------------------------------------------------*/
@@ -13,8 +17,9 @@ struct foo
 //  boost::intrusive::unordered_set_member_hook<link_mode> member_hook_;
   sdd::mem::intrusive_member_hook<foo> hook;
   int i_;
+  std::uint64_t id_;
 
-  foo(int i) : i_(i) {}
+  foo(int i) : i_(i), id_(0) {}
 
   bool
   operator==(const foo& other)
@@ -37,6 +42,49 @@ struct foo
   {
     return true;
   }
+
+  void
+  set_id(std::uint64_t id)
+  noexcept
+  {
+    id_ = id;
+  }
+};
+
+// Tell explicitly if it's referenced.
+struct bar
+{
+  sdd::mem::intrusive_member_hook<bar> hook;
+  int i_;
+  bool referenced_;
+
+  bar(int i) : i_(i), referenced_(true) {}
+
+  bool
+  operator==(const bar& other)
+  const noexcept
+  {
+    return i_ == other.i_;
+  }
+
+  std::size_t
+  extra_bytes()
+  const noexcept
+  {
+    return 0;
+  }
+
+  bool
+  is_not_referenced()
+  const noexcept
+  {
+    return not referenced_;
+  }
+
+  void
+  set_id(std::uint64_t)
+  noexcept
+  {}
 };
 
 }
@@ -54,6 +102,17 @@ struct hash<foo>
   }
 };
 
+template <>
+struct hash<bar>
+{
+  std::size_t
+  operator()(const bar& b)
+  const noexcept
+  {
+    return std::hash<int>()(b.i_);
+  }
+};
+
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -94,4 +153,99 @@ TEST(unique_table_test, insertion)
   }
 }
 
-/*------------------------------------------------------------------------------------------------*/
\ No newline at end of file
+/*------------------------------------------------------------------------------------------------*/
+TEST(unique_table_test, open_addressing)
+{
+  using unique_table_type = sdd::mem::unique_table<foo, sdd::mem::open_hash_table<foo>>;
+  unique_table_type ut(4);
+
+  std::vector<const foo*> unified;
+  for (int i = 0; i < 100; ++i)
+  {
+    char* addr = ut.allocate(0);
+    foo* ptr = new (addr) foo(i);
+    unified.push_back(&ut(ptr));
+  }
+  ASSERT_EQ(100ul, ut.stats().size);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    char* addr = ut.allocate(0);
+    foo* ptr = new (addr) foo(i);
+    ASSERT_EQ(unified[i], &ut(ptr));
+  }
+  ASSERT_EQ(100ul, ut.stats().hits);
+
+  for (const auto f : unified)
+  {
+    ut.erase(*f);
+  }
+  ASSERT_EQ(0ul, ut.stats().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, deferred_gc)
+{
+  sdd::mem::unique_table<bar> ut(100, false, 2 /* gc threshold */);
+  const auto unify = [&](int i) -> bar&
+                       {
+                         bar& b = ut(new (ut.allocate(0)) bar(i));
+                         b.referenced_ = true;
+                         return b;
+                       };
+  const auto release = [&](bar& b)
+                         {
+                           b.referenced_ = false;
+                           ut.erase(b);
+                         };
+
+  bar& b1 = unify(1);
+  release(b1);
+  ASSERT_EQ(1ul, ut.stats().size);
+  ASSERT_EQ(1ul, ut.stats().dead);
+
+  // A dead data is resurrected when it's unified again.
+  ASSERT_EQ(&b1, &unify(1));
+  ASSERT_EQ(0ul, ut.stats().dead);
+  ASSERT_EQ(1ul, ut.stats().resurrections);
+  release(b1);
+
+  bar& b2 = unify(2);
+  release(b2);
+  ASSERT_EQ(2ul, ut.stats().size);
+  ASSERT_EQ(2ul, ut.stats().dead);
+  ASSERT_EQ(0ul, ut.stats().sweeps);
+
+  // The threshold is reached.
+  bar& b3 = unify(3);
+  ASSERT_EQ(1ul, ut.stats().size);
+  ASSERT_EQ(0ul, ut.stats().dead);
+  ASSERT_EQ(1ul, ut.stats().sweeps);
+
+  release(b3);
+  ASSERT_EQ(1ul, ut.collect());
+  ASSERT_EQ(0ul, ut.stats().size);
+  ASSERT_EQ(0ul, ut.collect());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, identifiers)
+{
+  sdd::mem::unique_table<foo> ut(100);
+  const auto unify = [&](int i) -> const foo& {return ut(new (ut.allocate(0)) foo(i));};
+
+  const foo& f0 = unify(42);
+  const foo& f1 = unify(7);
+  const foo& f2 = unify(33);
+  ASSERT_EQ(0u, f0.id_);
+  ASSERT_EQ(1u, f1.id_);
+  ASSERT_EQ(2u, f2.id_);
+
+  // A hit doesn't consume an identifier.
+  ASSERT_EQ(1u, unify(7).id_);
+  ASSERT_EQ(3u, unify(0).id_);
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -152,3 +152,16 @@ TYPED_TEST(order_test, constructed_order)
 }
 
 /*-------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(order_test, hash)
+{
+  using ob = order_builder;
+  const order o1(ob("x", ob {"a", "b"}) << ob("y"));
+  const order o2(ob("x", ob {"a", "b"}) << ob("y"));
+  ASSERT_EQ(o1, o2);
+  ASSERT_EQ(std::hash<order>()(o1), std::hash<order>()(o2));
+  ASSERT_EQ(std::hash<order>()(o1.nested()), std::hash<order>()(o2.nested()));
+  ASSERT_EQ(std::hash<order>()(o1.next().next()), std::hash<order>()(order(ob {})));
+}
+
+/*-------------------------------------------------------------------------------------------*/
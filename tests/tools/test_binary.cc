@@ -0,0 +1,284 @@
+#include <cstdint> // uint64_t
+#include <cstdio>  // remove
+#include <fstream>
+#include <initializer_list>
+#include <limits>  // numeric_limits
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/dd/context.hh"
+#include "sdd/manager.hh"
+#include "sdd/tools/binary.hh"
+#include "sdd/tools/nodes.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+template <typename C>
+std::vector<sdd::SDD<C>>
+round_trip(const std::vector<sdd::SDD<C>>& xs)
+{
+  std::ostringstream os;
+  sdd::tools::save_binary(os, xs);
+  const auto data = os.str();
+  return sdd::tools::load_binary<C>(data.data(), data.size());
+}
+
+} // namespace anonymous
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct binary_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+  sdd::dd::context<C>& cxt;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  binary_test()
+    : m(sdd::manager<C>::init(small_conf<C>()))
+    , cxt(sdd::global<C>().sdd_context)
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(binary_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(binary_test, terminals)
+{
+  const auto xs = round_trip<conf>({zero, one});
+  ASSERT_EQ(2u, xs.size());
+  ASSERT_EQ(zero, xs[0]);
+  ASSERT_EQ(one, xs[1]);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(binary_test, same_sdd)
+{
+  const SDD x = sum(cxt, { SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one)))
+                         , SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one)))
+                         , SDD(2, {2, 3}, SDD(1, {1, 4}, SDD(0, {0, 5}, one)))});
+  const SDD y = SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one)));
+  const auto xs = round_trip<conf>({x, y, x});
+  ASSERT_EQ(3u, xs.size());
+  ASSERT_EQ(x, xs[0]);
+  ASSERT_EQ(y, xs[1]);
+  ASSERT_EQ(x, xs[2]);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(binary_test, shared_nodes)
+{
+  const SDD x = sum(cxt, { SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one)))
+                         , SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one)))});
+  std::ostringstream single;
+  sdd::tools::save_binary(single, x);
+  std::ostringstream twice;
+  sdd::tools::save_binary(twice, std::vector<SDD>{x, x});
+  // Only the root is written again.
+  ASSERT_EQ(single.str().size() + 2, twice.str().size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(binary_test, reload_released)
+{
+  const std::string path = "binary_test.sdd";
+  std::size_t size = 0;
+  std::pair<unsigned int, unsigned int> nodes;
+  {
+    const SDD x = sum(cxt, { SDD(3, {0}, SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one))))
+                           , SDD(3, {1}, SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one))))
+                           , SDD(3, {2}, SDD(2, {3}, SDD(1, {0, 7}, SDD(0, {2}, one))))});
+    size = static_cast<std::size_t>(x.size());
+    nodes = sdd::tools::nodes(x);
+    sdd::tools::save_binary(path, std::vector<SDD>{x});
+  }
+  const auto xs = sdd::tools::load_binary<conf>(path);
+  std::remove(path.c_str());
+  ASSERT_EQ(1u, xs.size());
+  ASSERT_EQ(size, static_cast<std::size_t>(xs[0].size()));
+  ASSERT_EQ(nodes, sdd::tools::nodes(xs[0]));
+
+  // Loaded nodes are unified with the ones built by operations.
+  const SDD x = sum(cxt, { SDD(3, {0}, SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one))))
+                         , SDD(3, {1}, SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one))))
+                         , SDD(3, {2}, SDD(2, {3}, SDD(1, {0, 7}, SDD(0, {2}, one))))});
+  ASSERT_EQ(x, xs[0]);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(binary_test, invalid_data)
+{
+  ASSERT_THROW(sdd::tools::load_binary<conf>("garbage", 7), std::runtime_error);
+
+  std::ostringstream os;
+  sdd::tools::save_binary(os, SDD(0, {0}, one));
+  const auto data = os.str();
+  ASSERT_THROW( sdd::tools::load_binary<conf>(data.data(), data.size() - 1)
+              , std::runtime_error);
+
+  ASSERT_THROW( sdd::tools::load_binary<conf>(std::string("/nonexistent/file"))
+              , std::runtime_error);
+
+  ASSERT_THROW( sdd::tools::save_binary(std::string("/nonexistent/file"), std::vector<SDD>{one})
+              , std::runtime_error);
+  if (std::ifstream("/dev/full"))
+  {
+    // Writes always fail on this device.
+    ASSERT_THROW( sdd::tools::save_binary(std::string("/dev/full"), std::vector<SDD>{one})
+                , std::runtime_error);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(binary_test, corrupted_data)
+{
+  // The encoding of SDD(0, {0}, one), with a given root's environment.
+  const auto encode = [](std::uint64_t level, std::uint64_t env_successor, std::uint64_t root)
+    -> std::string
+  {
+    std::ostringstream os;
+    os.write(sdd::tools::binary::magic, sizeof(sdd::tools::binary::magic));
+    for (std::uint64_t x : { sdd::tools::binary::version
+                             // A single set of values: {0}.
+                           , std::uint64_t(1), std::uint64_t(1), std::uint64_t(0)
+                             // A single node, with a single arc on {0} and empty stacks.
+                           , std::uint64_t(1), std::uint64_t(1), std::uint64_t(0)
+                           , std::uint64_t(0), std::uint64_t(0)
+                             // A single environment, with an empty values stack.
+                           , std::uint64_t(1), level, std::uint64_t(0)
+                           , std::uint64_t(1), env_successor
+                             // A single root.
+                           , std::uint64_t(1), std::uint64_t(0), root})
+    {
+      sdd::tools::binary::write(os, x);
+    }
+    return os.str();
+  };
+
+  {
+    const auto data = encode(1, 1, 2);
+    const auto xs = sdd::tools::load_binary<conf>(data.data(), data.size());
+    ASSERT_EQ(1u, xs.size());
+    ASSERT_EQ(SDD(0, {0}, one), xs[0]);
+  }
+  {
+    // A node at the level of |1|.
+    const auto data = encode(0, 1, 2);
+    ASSERT_THROW(sdd::tools::load_binary<conf>(data.data(), data.size()), std::runtime_error);
+  }
+  {
+    // |1| above the bottom level.
+    const auto data = encode(2, 1, 2);
+    ASSERT_THROW(sdd::tools::load_binary<conf>(data.data(), data.size()), std::runtime_error);
+  }
+  {
+    // A terminal with a non-empty environment.
+    const auto data = encode(1, 1, 1);
+    ASSERT_THROW(sdd::tools::load_binary<conf>(data.data(), data.size()), std::runtime_error);
+  }
+  {
+    // A level which doesn't fit an unsigned int, it would be read as 1 if truncated.
+    const auto data = encode((std::uint64_t(1) << 32) + 1, 1, 2);
+    ASSERT_THROW(sdd::tools::load_binary<conf>(data.data(), data.size()), std::runtime_error);
+  }
+  {
+    // An arc with an empty set of values.
+    std::ostringstream os;
+    os.write(sdd::tools::binary::magic, sizeof(sdd::tools::binary::magic));
+    for (std::uint64_t x : { sdd::tools::binary::version
+                           , std::uint64_t(1), std::uint64_t(0)
+                           , std::uint64_t(1), std::uint64_t(1), std::uint64_t(0)
+                           , std::uint64_t(0), std::uint64_t(0)
+                           , std::uint64_t(1), std::uint64_t(1), std::uint64_t(0)
+                           , std::uint64_t(1), std::uint64_t(1)
+                           , std::uint64_t(1), std::uint64_t(0), std::uint64_t(2)})
+    {
+      sdd::tools::binary::write(os, x);
+    }
+    const auto data = os.str();
+    ASSERT_THROW(sdd::tools::load_binary<conf>(data.data(), data.size()), std::runtime_error);
+  }
+  {
+    // A number of values sets which can't fit in the data.
+    std::ostringstream os;
+    os.write(sdd::tools::binary::magic, sizeof(sdd::tools::binary::magic));
+    sdd::tools::binary::write(os, sdd::tools::binary::version);
+    sdd::tools::binary::write(os, std::uint64_t(1) << 60);
+    const auto data = os.str();
+    ASSERT_THROW(sdd::tools::load_binary<conf>(data.data(), data.size()), std::runtime_error);
+  }
+  {
+    // Sets of values which don't fit value_type, or which are not strictly increasing.
+    const auto encode_values = [](std::initializer_list<std::uint64_t> deltas)
+      -> std::string
+    {
+      std::ostringstream os;
+      os.write(sdd::tools::binary::magic, sizeof(sdd::tools::binary::magic));
+      sdd::tools::binary::write(os, sdd::tools::binary::version);
+      sdd::tools::binary::write(os, 1);
+      sdd::tools::binary::write(os, deltas.size());
+      for (const auto delta : deltas)
+      {
+        sdd::tools::binary::write(os, delta);
+      }
+      // No nodes, environments or roots.
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        sdd::tools::binary::write(os, 0);
+      }
+      return os.str();
+    };
+    using value_type = typename TestFixture::configuration_type::Values::value_type;
+    const std::uint64_t max = std::numeric_limits<value_type>::max();
+
+    const auto valid = encode_values({0, 1, max - 1});
+    ASSERT_NO_THROW(sdd::tools::load_binary<conf>(valid.data(), valid.size()));
+    const auto too_large = encode_values({max + 1});
+    ASSERT_THROW( sdd::tools::load_binary<conf>(too_large.data(), too_large.size())
+                , std::runtime_error);
+    const auto overflow = encode_values({max, 1});
+    ASSERT_THROW( sdd::tools::load_binary<conf>(overflow.data(), overflow.size())
+                , std::runtime_error);
+    const auto duplicate = encode_values({1, 0});
+    ASSERT_THROW( sdd::tools::load_binary<conf>(duplicate.data(), duplicate.size())
+                , std::runtime_error);
+  }
+  {
+    // A node without arcs.
+    std::ostringstream os;
+    os.write(sdd::tools::binary::magic, sizeof(sdd::tools::binary::magic));
+    for (std::uint64_t x : {sdd::tools::binary::version, std::uint64_t(0), std::uint64_t(1)
+                           , std::uint64_t(0), std::uint64_t(0), std::uint64_t(0)})
+    {
+      sdd::tools::binary::write(os, x);
+    }
+    const auto data = os.str();
+    ASSERT_THROW(sdd::tools::load_binary<conf>(data.data(), data.size()), std::runtime_error);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,163 @@
+#include <algorithm> // set_difference, set_intersection, set_union
+#include <cstdint>   // uint32_t
+#include <iterator>  // back_inserter
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/util/set_operations.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using namespace sdd::util;
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+using vector = std::vector<std::uint32_t>;
+
+/// @brief Get the instruction sets supported by the running CPU.
+std::vector<simd_level>
+levels()
+{
+  std::vector<simd_level> res {simd_level::none};
+  if (detected_simd_level() != simd_level::none)
+  {
+    res.push_back(simd_level::sse42);
+  }
+  if (detected_simd_level() == simd_level::avx2)
+  {
+    res.push_back(simd_level::avx2);
+  }
+  return res;
+}
+
+/// @brief Draw a sorted array of n distinct integers lower than max.
+vector
+draw(std::mt19937& gen, std::size_t n, std::uint32_t max)
+{
+  std::uniform_int_distribution<std::uint32_t> dist(0, max - 1);
+  vector res;
+  while (res.size() < n)
+  {
+    for (auto i = res.size(); i < n; ++i)
+    {
+      res.push_back(dist(gen));
+    }
+    std::sort(res.begin(), res.end());
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+  }
+  return res;
+}
+
+/// @brief Check all operations on a and b against the standard algorithms.
+void
+check(simd_level level, const vector& a, const vector& b)
+{
+  vector out(a.size() + b.size() + set_operations_padding);
+  {
+    vector expected;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    const auto n = set_union(level, a.data(), a.size(), b.data(), b.size(), out.data());
+    ASSERT_EQ(expected, vector(out.begin(), out.begin() + n));
+  }
+  {
+    vector expected;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    const auto n = set_intersection(level, a.data(), a.size(), b.data(), b.size(), out.data());
+    ASSERT_EQ(expected, vector(out.begin(), out.begin() + n));
+  }
+  {
+    vector expected;
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    const auto n = set_difference(level, a.data(), a.size(), b.data(), b.size(), out.data());
+    ASSERT_EQ(expected, vector(out.begin(), out.begin() + n));
+  }
+}
+
+} // namespace anonymous
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(set_operations_test, small)
+{
+  for (const auto level : levels())
+  {
+    check(level, {}, {});
+    check(level, {1, 2, 3}, {});
+    check(level, {}, {1, 2, 3});
+    check(level, {1, 2, 3, 4, 5, 6, 7, 8}, {1, 2, 3, 4, 5, 6, 7, 8});
+    check(level, {0, 2, 4, 6, 8, 10, 12, 14}, {1, 3, 5, 7, 9, 11, 13, 15});
+    check(level, {0, 1, 2, 3, 4, 5, 6, 7}, {4, 5, 6, 7, 8, 9, 10, 11});
+    check(level, {0, 0xFFFFFFFF}, {0, 1, 2, 3, 0xFFFFFFFE, 0xFFFFFFFF});
+    check(level, {0, 1, 2, 3, 0xFFFFFFFE, 0xFFFFFFFF}, {0, 1, 2, 0xFFFFFFFF});
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(set_operations_test, random)
+{
+  std::mt19937 gen(0);
+  for (const auto level : levels())
+  {
+    for (std::size_t na = 0; na < 40; ++na)
+    {
+      for (std::size_t nb = 0; nb < 40; nb += 3)
+      {
+        // Dense values, thus many common values.
+        check(level, draw(gen, na, 64), draw(gen, nb, 64));
+        check(level, draw(gen, na, 1000), draw(gen, nb, 1000));
+      }
+    }
+    for (std::size_t i = 0; i < 20; ++i)
+    {
+      check(level, draw(gen, 500, 2000), draw(gen, 700, 2000));
+      check(level, draw(gen, 2000, 8000), draw(gen, 3000, 8000));
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(set_operations_test, skewed)
+{
+  std::mt19937 gen(0);
+  for (const auto level : levels())
+  {
+    for (std::size_t n = 0; n < 10; ++n)
+    {
+      const auto large = draw(gen, 2000, 4000);
+      const auto small = draw(gen, n, 4000);
+      check(level, large, small);
+      check(level, small, large);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(set_operations_test, generic)
+{
+  const std::vector<long> a {-5, -1, 0, 3, 7};
+  const std::vector<long> b {-1, 3, 8};
+  {
+    std::vector<long> out(a.size() + b.size());
+    out.resize(set_union(a.data(), a.size(), b.data(), b.size(), out.data()));
+    ASSERT_EQ((std::vector<long>{-5, -1, 0, 3, 7, 8}), out);
+  }
+  {
+    std::vector<long> out(b.size());
+    out.resize(set_intersection(a.data(), a.size(), b.data(), b.size(), out.data()));
+    ASSERT_EQ((std::vector<long>{-1, 3}), out);
+  }
+  {
+    std::vector<long> out(a.size());
+    out.resize(set_difference(a.data(), a.size(), b.data(), b.size(), out.data()));
+    ASSERT_EQ((std::vector<long>{-5, 0, 7}), out);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,76 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/util/work_stealing_pool.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using namespace sdd::util;
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(work_stealing_pool_test, no_worker)
+{
+  work_stealing_pool pool(0);
+  ASSERT_EQ(0u, pool.size());
+  std::vector<unsigned int> v(100, 0);
+  pool.parallel_for(v.size(), 7, [&](std::size_t i){v[i] = i;});
+  for (std::size_t i = 0; i < v.size(); ++i)
+  {
+    ASSERT_EQ(i, v[i]);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(work_stealing_pool_test, parallel_for)
+{
+  work_stealing_pool pool(4);
+  ASSERT_EQ(4u, pool.size());
+  for (std::size_t grain : {0u, 1u, 3u, 1000u, 2000u})
+  {
+    std::vector<unsigned int> v(1000, 0);
+    pool.parallel_for(v.size(), grain, [&](std::size_t i){v[i] += i;});
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+      ASSERT_EQ(i, v[i]);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(work_stealing_pool_test, nested)
+{
+  work_stealing_pool pool(3);
+  std::atomic<std::size_t> count(0);
+  pool.parallel_for(20, 1, [&](std::size_t)
+                           {
+                             pool.parallel_for(50, 2, [&](std::size_t){++count;});
+                           });
+  ASSERT_EQ(1000u, count.load());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(work_stealing_pool_test, exception)
+{
+  work_stealing_pool pool(2);
+  std::atomic<std::size_t> count(0);
+  ASSERT_THROW( pool.parallel_for(100, 1, [&](std::size_t i)
+                                          {
+                                            ++count;
+                                            if (i == 42)
+                                            {
+                                              throw std::runtime_error("");
+                                            }
+                                          })
+              , std::runtime_error);
+  // All tasks are completed before the exception is rethrown.
+  ASSERT_EQ(100u, count.load());
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,254 @@
+#include <algorithm> // set_difference, set_intersection, set_union
+#include <iterator>  // back_inserter
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/values/interval_set.hh"
+#include "sdd/values_manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct interval_set_test
+  : public testing::Test
+{
+  struct conf
+  {
+    std::size_t interval_set_unique_table_size;
+    conf()
+      : interval_set_unique_table_size(100)
+    {
+    }
+  };
+
+  typedef sdd::values::interval_set<unsigned int> interval_set;
+  typedef sdd::values::interval_set_builder<unsigned int> builder;
+  typedef std::vector<unsigned int> vector;
+  sdd::values_manager<interval_set> m_;
+
+  interval_set_test()
+    : m_(conf())
+  {
+    *sdd::global_values_ptr<interval_set>() = &m_;
+  }
+
+  ~interval_set_test()
+  {
+    *sdd::global_values_ptr<interval_set>() = nullptr;
+  }
+
+  /// @brief Get the set of all values of [first, last].
+  static
+  interval_set
+  range(unsigned int first, unsigned int last)
+  {
+    builder b;
+    b.insert(first, last);
+    return interval_set(std::move(b));
+  }
+
+  /// @brief Draw a few ranges of values lower than max.
+  static
+  vector
+  draw(std::mt19937& gen, std::size_t n, unsigned int max)
+  {
+    std::uniform_int_distribution<unsigned int> dist(0, max - 1);
+    std::uniform_int_distribution<unsigned int> length(0, 20);
+    std::set<unsigned int> res;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const auto first = dist(gen);
+      for (auto v = first; v < std::min(max, first + length(gen)); ++v)
+      {
+        res.insert(v);
+      }
+    }
+    return vector(res.begin(), res.end());
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, empty)
+{
+  interval_set s;
+  ASSERT_TRUE(s.empty());
+  ASSERT_EQ(0u, s.size());
+  ASSERT_EQ(s.cbegin(), s.cend());
+  ASSERT_EQ(interval_set(), range(3, 2));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, construction)
+{
+  const interval_set s {5, 1, 2, 3, 7, 6, 10};
+  ASSERT_EQ(7u, s.size());
+  ASSERT_EQ(3u, s.intervals().size());
+  ASSERT_EQ((vector {1, 2, 3, 5, 6, 7, 10}), vector(s.cbegin(), s.cend()));
+  ASSERT_EQ(s, interval_set({10, 7, 6, 5, 3, 2, 1}));
+  std::stringstream ss;
+  ss << s;
+  ASSERT_EQ("{1..3,5..7,10}", ss.str());
+
+  builder b;
+  b.insert(0, 10);
+  b.insert(5, 20);
+  b.insert(21);
+  b.insert(4294967295u);
+  const interval_set r(std::move(b));
+  ASSERT_EQ(2u, r.intervals().size());
+  ASSERT_EQ(23u, r.size());
+  ASSERT_TRUE(r.contains(21));
+  ASSERT_FALSE(r.contains(22));
+  ASSERT_TRUE(r.contains(4294967295u));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, insertion)
+{
+  interval_set s;
+  ASSERT_TRUE(s.insert(10));
+  ASSERT_TRUE(s.insert(12));
+  ASSERT_FALSE(s.insert(12));
+  ASSERT_EQ(2u, s.intervals().size());
+  ASSERT_TRUE(s.insert(11));
+  ASSERT_EQ(1u, s.intervals().size());
+  ASSERT_EQ(range(10, 12), s);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, erase)
+{
+  interval_set s = range(10, 12);
+  ASSERT_EQ(1u, s.erase(11));
+  ASSERT_EQ((interval_set {10, 12}), s);
+  ASSERT_EQ(0u, s.erase(11));
+  ASSERT_EQ(1u, s.erase(10));
+  ASSERT_EQ(1u, s.erase(12));
+  ASSERT_TRUE(s.empty());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, translation)
+{
+  const auto s = sum(range(10, 20), range(100, 1000000));
+  ASSERT_EQ(sum(range(0, 10), range(90, 999990)), s.translate_down(10));
+  ASSERT_EQ(s, s.translate_down(10).translate_up(10));
+  ASSERT_EQ(s, s.translate_up(0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, difference)
+{
+  interval_set empty;
+  const auto s = range(0, 100);
+  ASSERT_EQ(s, difference(s, empty));
+  ASSERT_EQ(empty, difference(empty, s));
+  ASSERT_EQ(empty, difference(s, s));
+  ASSERT_EQ( sum(range(0, 9), range(21, 100))
+           , difference(s, range(10, 20)));
+  ASSERT_EQ(range(50, 100), difference(s, range(0, 49)));
+  ASSERT_EQ(s, difference(s, range(101, 200)));
+  ASSERT_EQ(range(101, 200), difference(range(0, 200), s));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, intersection)
+{
+  interval_set empty;
+  const auto s = range(0, 100);
+  ASSERT_EQ(empty, intersection(empty, s));
+  ASSERT_EQ(empty, intersection(s, empty));
+  ASSERT_EQ(range(50, 100), intersection(s, range(50, 200)));
+  ASSERT_EQ(empty, intersection(s, range(101, 200)));
+  ASSERT_EQ( sum(range(90, 99), interval_set {0})
+           , intersection(s, sum(range(90, 99), interval_set {0, 101, 102})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, sum)
+{
+  interval_set empty;
+  const auto s = range(0, 100);
+  ASSERT_EQ(s, sum(empty, s));
+  ASSERT_EQ(s, sum(s, empty));
+  ASSERT_EQ(range(0, 200), sum(s, range(101, 200)));
+  ASSERT_EQ(range(0, 200), sum(range(50, 200), s));
+  ASSERT_EQ(2u, sum(s, range(102, 200)).intervals().size());
+  ASSERT_EQ(range(0, 4294967295u), sum(s, range(50, 4294967295u)));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(interval_set_test, random)
+{
+  std::mt19937 gen(0);
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    const auto a = draw(gen, i % 20, 300);
+    const auto b = draw(gen, i % 7, 300);
+    const interval_set sa(a.begin(), a.end());
+    const interval_set sb(b.begin(), b.end());
+    ASSERT_EQ(a, vector(sa.cbegin(), sa.cend()));
+    {
+      vector expected;
+      std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+      ASSERT_EQ(interval_set(expected.begin(), expected.end()), sum(sa, sb));
+    }
+    {
+      vector expected;
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+      ASSERT_EQ(interval_set(expected.begin(), expected.end()), intersection(sa, sb));
+    }
+    {
+      vector expected;
+      std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+      ASSERT_EQ(interval_set(expected.begin(), expected.end()), difference(sa, sb));
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_sdd_test, ranges)
+{
+  auto m = sdd::manager<sdd::conf3>::init(small_conf<sdd::conf3>());
+  using SDD = sdd::SDD<sdd::conf3>;
+  using values_type = sdd::conf3::Values;
+  const auto one = sdd::one<sdd::conf3>();
+
+  const auto range = [](unsigned int first, unsigned int last)
+                       {
+                         sdd::values::interval_set_builder<unsigned int> b;
+                         b.insert(first, last);
+                         return values_type(std::move(b));
+                       };
+
+  // Large ranges, shifted and rebuilt at once by the proto encoding.
+  const SDD x(1, range(1000, 100000), SDD(0, range(5, 10), one));
+  const SDD y(1, range(50000, 200000), SDD(0, range(5, 10), one));
+  ASSERT_EQ(6u * 99001u, x.size());
+  ASSERT_EQ(SDD(1, range(1000, 200000), SDD(0, range(5, 10), one)), x + y);
+  ASSERT_EQ(SDD(1, range(50000, 100000), SDD(0, range(5, 10), one)), x & y);
+  ASSERT_EQ(SDD(1, range(1000, 49999), SDD(0, range(5, 10), one)), x - y);
+
+  const SDD z(1, range(1000, 100000), SDD(0, range(20, 30), one));
+  ASSERT_EQ(6u * 99001u + 11u * 99001u, (x + z).size());
+  ASSERT_EQ(x, (x + z) - z);
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,312 @@
+#include <algorithm> // min_element, set_difference, set_intersection, set_union
+#include <iterator>  // back_inserter
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/values/roaring.hh"
+#include "sdd/values_manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct roaring_test
+  : public testing::Test
+{
+  struct conf
+  {
+    std::size_t roaring_unique_table_size;
+    conf()
+      : roaring_unique_table_size(100)
+    {
+    }
+  };
+
+  typedef sdd::values::roaring<unsigned int> roaring;
+  typedef std::vector<unsigned int> vector;
+  sdd::values_manager<roaring> m_;
+
+  roaring_test()
+    : m_(conf())
+  {
+    *sdd::global_values_ptr<roaring>() = &m_;
+  }
+
+  ~roaring_test()
+  {
+    *sdd::global_values_ptr<roaring>() = nullptr;
+  }
+
+  /// @brief Draw n values lower than max, spread over several containers.
+  static
+  vector
+  draw(std::mt19937& gen, std::size_t n, unsigned int max)
+  {
+    std::uniform_int_distribution<unsigned int> dist(0, max - 1);
+    std::set<unsigned int> res;
+    while (res.size() < n)
+    {
+      res.insert(dist(gen));
+    }
+    return vector(res.begin(), res.end());
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, empty)
+{
+  roaring r;
+  ASSERT_TRUE(r.empty());
+  ASSERT_EQ(0u, r.size());
+  ASSERT_EQ(r.cbegin(), r.cend());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, insertion)
+{
+  roaring r;
+  ASSERT_TRUE(r.insert(10));
+  ASSERT_TRUE(r.insert(1));
+  ASSERT_TRUE(r.insert(70000));
+  ASSERT_FALSE(r.insert(1));
+  ASSERT_FALSE(r.insert(70000));
+  ASSERT_EQ(roaring({1,10,70000}), r);
+  ASSERT_EQ(3u, r.size());
+  ASSERT_TRUE(r.contains(70000));
+  ASSERT_FALSE(r.contains(70001));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, erase)
+{
+  roaring r{1, 33, 70000};
+  ASSERT_EQ(1u, r.erase(1));
+  ASSERT_EQ((roaring {33, 70000}), r);
+  ASSERT_EQ(0u, r.erase(1));
+  ASSERT_EQ((roaring {33, 70000}), r);
+  ASSERT_EQ(1u, r.erase(70000));
+  ASSERT_EQ(1u, r.erase(33));
+  ASSERT_TRUE(r.empty());
+  ASSERT_EQ(roaring(), r);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, unicity)
+{
+  {
+    roaring r1;
+    roaring r2;
+    ASSERT_EQ(r1, r2);
+  }
+  {
+    roaring r1 {1,2,3};
+    roaring r2 {3,2,1,2};
+    ASSERT_EQ(r1, r2);
+  }
+  {
+    // A dense set built by a union is unified with the same set built at once.
+    vector evens;
+    vector odds;
+    vector all;
+    for (unsigned int i = 0; i < 10000; ++i)
+    {
+      (i % 2 == 0 ? evens : odds).push_back(i);
+      all.push_back(i);
+    }
+    const roaring r1(all.begin(), all.end());
+    const roaring r2 = sum(roaring(evens.begin(), evens.end()), roaring(odds.begin(), odds.end()));
+    ASSERT_EQ(r1, r2);
+    ASSERT_EQ(10000u, r2.size());
+    // Back to an array container.
+    ASSERT_EQ( roaring(evens.begin(), evens.end())
+             , difference(r1, roaring(odds.begin(), odds.end())));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, iteration)
+{
+  const vector values {0, 1, 63, 64, 65535, 65536, 131071, 4294967295u};
+  const roaring r(values.rbegin(), values.rend());
+  ASSERT_EQ(values, vector(r.cbegin(), r.cend()));
+  std::stringstream ss;
+  ss << roaring {3, 1, 2};
+  ASSERT_EQ("{1,2,3}", ss.str());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, difference)
+{
+  roaring empty;
+  roaring r1 {1,2,3};
+  roaring r2 {2,3,5};
+  ASSERT_TRUE(difference(empty, empty).empty());
+  ASSERT_EQ(r1, difference(r1, empty));
+  ASSERT_EQ(empty, difference(empty, r1));
+  ASSERT_EQ(empty, difference(r1, r1));
+  ASSERT_EQ((roaring {1}), difference(r1, r2));
+  ASSERT_EQ((roaring {5}), difference(r2, r1));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, intersection)
+{
+  roaring empty;
+  roaring r1 {1,2,3};
+  roaring r2 {2,3,5};
+  ASSERT_TRUE(intersection(empty, empty).empty());
+  ASSERT_EQ(empty, intersection(empty, r1));
+  ASSERT_EQ(empty, intersection(r1, empty));
+  ASSERT_EQ((roaring {2,3}), intersection(r1, r2));
+  ASSERT_EQ((roaring {2,3}), intersection(r2, r1));
+  ASSERT_EQ(empty, intersection(r1, roaring {70001}));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, sum)
+{
+  roaring empty;
+  roaring r1 {1,2,3};
+  roaring r2 {2,3,5};
+  ASSERT_TRUE(sum(empty, empty).empty());
+  ASSERT_EQ(r1, sum(empty, r1));
+  ASSERT_EQ(r1, sum(r1, empty));
+  ASSERT_EQ((roaring {1,2,3,5}), sum(r1, r2));
+  ASSERT_EQ((roaring {1,2,3,5}), sum(r2, r1));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, random)
+{
+  std::mt19937 gen(0);
+  // Sizes around the limit between array and bitmap containers, in one or several containers.
+  const std::size_t sizes[] = {0, 10, 3000, 4096, 5000, 20000};
+  const unsigned int maxs[] = {8192, 65536, 200000};
+  for (const auto max : maxs)
+  {
+    for (const auto na : sizes)
+    {
+      for (const auto nb : sizes)
+      {
+        if (na >= max or nb >= max)
+        {
+          continue;
+        }
+        const auto a = draw(gen, na, max);
+        const auto b = draw(gen, nb, max);
+        const roaring ra(a.begin(), a.end());
+        const roaring rb(b.begin(), b.end());
+        ASSERT_EQ(na, ra.size());
+        ASSERT_EQ(a, vector(ra.cbegin(), ra.cend()));
+        {
+          vector expected;
+          std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+          const auto res = sum(ra, rb);
+          ASSERT_EQ(expected, vector(res.cbegin(), res.cend()));
+          ASSERT_EQ(expected.size(), res.size());
+          ASSERT_EQ(roaring(expected.begin(), expected.end()), res);
+        }
+        {
+          vector expected;
+          std::set_intersection( a.begin(), a.end(), b.begin(), b.end()
+                               , std::back_inserter(expected));
+          const auto res = intersection(ra, rb);
+          ASSERT_EQ(expected, vector(res.cbegin(), res.cend()));
+          ASSERT_EQ(expected.size(), res.size());
+          ASSERT_EQ(roaring(expected.begin(), expected.end()), res);
+        }
+        {
+          vector expected;
+          std::set_difference( a.begin(), a.end(), b.begin(), b.end()
+                             , std::back_inserter(expected));
+          const auto res = difference(ra, rb);
+          ASSERT_EQ(expected, vector(res.cbegin(), res.cend()));
+          ASSERT_EQ(expected.size(), res.size());
+          ASSERT_EQ(roaring(expected.begin(), expected.end()), res);
+        }
+      }
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+/// @brief A configuration like conf1, with roaring values.
+struct roaring_conf
+  : public sdd::roaring_default_configuration
+{
+  using Identifier = std::string;
+  using Values     = sdd::values::roaring<unsigned int>;
+
+  template <typename InputIterator>
+  static
+  unsigned int
+  common(InputIterator it, InputIterator end)
+  noexcept
+  {
+    return *std::min_element(it, end);
+  }
+
+  static
+  unsigned int
+  shift(unsigned int v, unsigned int k)
+  noexcept
+  {
+    return v - k;
+  }
+
+  static
+  unsigned int
+  rebuild(unsigned int v, unsigned int k)
+  noexcept
+  {
+    return v + k;
+  }
+};
+
+} // namespace anonymous
+
+TEST(roaring_sdd_test, dense_domain)
+{
+  auto m = sdd::manager<roaring_conf>::init(small_conf<roaring_conf>());
+  using SDD = sdd::SDD<roaring_conf>;
+  using values_type = roaring_conf::Values;
+  std::vector<unsigned int> low;
+  std::vector<unsigned int> high;
+  for (unsigned int i = 0; i < 6000; ++i)
+  {
+    low.push_back(i);
+    high.push_back(i + 3000);
+  }
+  const SDD x(0, values_type(low.begin(), low.end()), sdd::one<roaring_conf>());
+  const SDD y(0, values_type(high.begin(), high.end()), sdd::one<roaring_conf>());
+  ASSERT_EQ(9000u, (x + y).size());
+  ASSERT_EQ(3000u, (x & y).size());
+  ASSERT_EQ(3000u, (x - y).size());
+  std::vector<unsigned int> all;
+  for (unsigned int i = 0; i < 9000; ++i)
+  {
+    all.push_back(i);
+  }
+  ASSERT_EQ(SDD(0, values_type(all.begin(), all.end()), sdd::one<roaring_conf>()), x + y);
+}
+
+/*------------------------------------------------------------------------------------------------*/